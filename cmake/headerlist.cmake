@@ -3,6 +3,9 @@ set(headers ${headers}
 	include/Utils.h
 	include/PCH.h
 	include/Settings.h
+	include/Profiling.h
+	include/Papyrus.h
+	include/TraceRecorder.h
 	include/Manager.h
 	include/Events.h
 	include/Hooks.h
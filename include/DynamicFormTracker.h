@@ -1,173 +1,528 @@
+#pragma once
+
 #include "Utils.h"
+#include "Profiling.h"
+#include "TraceRecorder.h"
+
+using BaseKey = Utilities::Types::BaseKey;
+using BaseKeyHash = Utilities::Types::BaseKeyHash;
 
 struct ActEff {
-    FormID baseFormid;
+    BaseKey base;
     FormID dynamicFormid;
     float elapsed;
     std::pair<bool, uint32_t> custom_id;
 
 };
 
-class DynamicFormTracker : public Utilities::DFSaveLoadData {
-    
-    // created form bank during the session. Create populates this.
-    std::map<std::pair<FormID, std::string>, std::set<FormID>> forms;
-    std::map<FormID, uint32_t> customIDforms; // Fetch populates this
+// act effs keyed by their dynamic formid: O(1) lookup and duplicate check, iteration over one flat vector
+class ActEffStore {
+    std::vector<ActEff> effs;
+    std::unordered_map<FormID, std::size_t> index;  // dynamicFormid -> position in effs
 
-    std::set<FormID> active_forms; // _yield populates this
-    std::set<FormID> deleted_forms;
+public:
+    // false if the form already has an entry
+    bool Insert(const ActEff& act_eff) {
+        if (!index.try_emplace(act_eff.dynamicFormid, effs.size()).second) return false;
+        effs.push_back(act_eff);
+        return true;
+    }
 
+    [[nodiscard]] const ActEff* Find(const FormID dynamic_formid) const {
+        const auto it = index.find(dynamic_formid);
+        return it != index.end() ? &effs[it->second] : nullptr;
+    }
 
-    std::mutex mutex;
-    const unsigned int form_limit = 10000;
-    bool block_create = false;
+    void Clear() {
+        effs.clear();
+        index.clear();
+    }
 
-    //std::map<FormID,float> act_effs;
-    std::vector<ActEff> act_effs; // save file specific
-
-    void CleanseFormsets() {
-        for (auto it = forms.begin(); it != forms.end(); ++it) {
-            auto& [base, formset] = *it;
-            for (auto it2 = formset.begin(); it2 != formset.end();) {
-                if (!Utilities::FunctionsSkyrim::GetFormByID(*it2)) {
-                    logger::trace("Form with ID {:x} does not exist. Removing from formset.", *it2);
-                    it2 = formset.erase(it2);
-                    customIDforms.erase(*it2);
-                    active_forms.erase(*it2);
-                    //deleted_forms.erase(*it2);
-                } else {
-                    ++it2;
-                }
-            }
-        }
+    [[nodiscard]] std::size_t size() const { return effs.size(); }
+    [[nodiscard]] bool empty() const { return effs.empty(); }
+    [[nodiscard]] auto begin() const { return effs.begin(); }
+    [[nodiscard]] auto end() const { return effs.end(); }
+};
+
+// One tracked and one active bit per formid of the dynamic range, so IsTracked/IsActive need no lock.
+// Written only under the tracker's exclusive lock; formids outside the range read as unset.
+class DynamicFormFlags {
+public:
+    static constexpr FormID kFirst = 0xFF000000;
+    static constexpr FormID kLast = 0xFF3DFFFF;
+
+    enum Flag : std::uint32_t { kTracked = 1, kActive = 2 };
+
+    [[nodiscard]] bool Test(const FormID formid, const Flag flag) const {
+        if (formid < kFirst || formid > kLast) return false;
+        const auto [word, shift] = _locate(formid);
+        return words[word].load(std::memory_order_acquire) >> shift & flag;
     }
 
-	[[nodiscard]] const float GetActiveEffectElapsed(const FormID dyn_formid) {
-		for (const auto& act_eff : act_effs) {
-			if (act_eff.dynamicFormid == dyn_formid) {
-				return act_eff.elapsed;
-			}
-		}
-		return -1.f;
-	}
+    void Set(const FormID formid, const Flag flag, const bool value) {
+        if (formid < kFirst || formid > kLast) return;
+        const auto [word, shift] = _locate(formid);
+        if (value) words[word].fetch_or(flag << shift, std::memory_order_release);
+        else words[word].fetch_and(~(flag << shift), std::memory_order_release);
+    }
 
-    [[nodiscard]] const bool IsTracked(const FormID dynamic_formid){
-        for (const auto& [base_pair, dyn_formset] : forms) {
-			if (dyn_formset.contains(dynamic_formid)) {
-				return true;
-			}
-		}
-		return false;
+    void Clear(const Flag flag) {
+        std::uint32_t mask = 0;
+        for (std::uint32_t shift = 0; shift < 32; shift += kBits) mask |= flag << shift;
+        for (std::size_t i = 0; i < kWords; ++i) words[i].fetch_and(~mask, std::memory_order_release);
     }
 
-    [[maybe_unused]] RE::TESForm* GetOGFormOfDynamic(const FormID dynamic_formid) {
-		for (const auto& [base_pair, dyn_formset] : forms) {
-			if (dyn_formset.contains(dynamic_formid)) {
-				return Utilities::FunctionsSkyrim::GetFormByID(base_pair.first, base_pair.second);
-			}
-		}
-		return nullptr;
-	}
+private:
+    static constexpr std::uint32_t kBits = 2;
+    static constexpr std::size_t kPerWord = 32 / kBits;
+    static constexpr std::size_t kWords = (kLast - kFirst) / kPerWord + 1;
 
-    void ReviveDynamicForm(RE::TESForm* fake, RE::TESForm* base, const FormID setFormID) {
+    [[nodiscard]] static std::pair<std::size_t, std::uint32_t> _locate(const FormID formid) {
+        const auto offset = formid - kFirst;
+        return {offset / kPerWord, static_cast<std::uint32_t>(offset % kPerWord) * kBits};
+    }
+
+    std::unique_ptr<std::atomic<std::uint32_t>[]> words = std::make_unique<std::atomic<std::uint32_t>[]>(kWords);
+};
+
+// Copies what ReviveDynamicForm takes over from a base onto a fake of the same form class. For each class in Forms the
+// copier is generated at compile time: a static cast per component in Components the class derives from and its own
+// fields, with no casts that can fail. Other types, and fakes whose type differs from the base, go by dynamic casts.
+class FormReviver {
+public:
+    using Copier = void (*)(RE::TESForm* from, RE::TESForm* to);
+
+    // components copied, in this order, where the form class has them
+    using Components = std::tuple<RE::TESDescription,
+                                  RE::BGSKeywordForm,
+                                  RE::BGSPickupPutdownSounds,
+                                  RE::TESModelTextureSwap,
+                                  RE::TESModel,
+                                  RE::BGSMessageIcon,
+                                  RE::TESIcon,
+                                  RE::TESFullName,
+                                  RE::TESValueForm,
+                                  RE::TESWeightForm,
+                                  RE::BGSDestructibleObjectForm,
+                                  RE::TESEnchantableForm,
+                                  RE::BGSBlockBashData,
+                                  RE::BGSEquipType,
+                                  RE::TESAttackDamageForm,
+                                  RE::TESBipedModelForm>;
+
+    // form classes with a compiled copier, each in the slot of its FORMTYPE
+    using Forms = std::tuple<RE::TESObjectWEAP,
+                             RE::TESObjectARMO,
+                             RE::TESObjectBOOK,
+                             RE::TESAmmo,
+                             RE::TESObjectMISC,
+                             RE::TESKey,
+                             RE::TESSoulGem,
+                             RE::TESObjectLIGT,
+                             RE::AlchemyItem,
+                             RE::IngredientItem,
+                             RE::SpellItem,
+                             RE::ScrollItem,
+                             RE::EnchantmentItem,
+                             RE::EffectSetting>;
+
+private:
+    // a base the static cast can reach unambiguously
+    template <class Form, class Component>
+    static constexpr bool kHas = std::is_base_of_v<Component, Form> && requires(Form* form) {
+        static_cast<Component*>(form);
+    };
+
+    template <class Form, class... Ts>
+    static void _copy_components(Form* from, Form* to, std::type_identity<std::tuple<Ts...>>) {
+        (
+            [&] {
+                if constexpr (kHas<Form, Ts>) static_cast<Ts*>(to)->CopyComponent(static_cast<Ts*>(from));
+            }(),
+            ...);
+    }
+
+    template <class Form>
+    static void _revive_as(RE::TESForm* a_from, RE::TESForm* a_to) {
+        if constexpr (std::is_same_v<Form, RE::TESObjectWEAP>) _copy_weapon_fields(a_from, a_to);
+        else if constexpr (std::is_same_v<Form, RE::TESObjectBOOK>) _copy_book_fields(a_from, a_to);
+        else if constexpr (std::is_same_v<Form, RE::TESAmmo>) _copy_ammo_fields(a_from, a_to);
+        _copy_components(static_cast<Form*>(a_from), static_cast<Form*>(a_to), std::type_identity<Components>{});
+    }
+
+    template <class... Fs>
+    static constexpr std::array<Copier, 256> _make_copiers(std::type_identity<std::tuple<Fs...>>) {
+        std::array<Copier, 256> copiers{};
+        ((copiers[std::to_underlying(Fs::FORMTYPE)] = &_revive_as<Fs>), ...);
+        return copiers;
+    }
+
+public:
+    // nullptr if the type has no compiled copier
+    [[nodiscard]] static Copier Get(const RE::FormType type) {
+        static constexpr auto copiers = _make_copiers(std::type_identity<Forms>{});
+        return copiers[std::to_underlying(type)];
+    }
+
+    static void ReviveByCasts(RE::TESForm* fake, RE::TESForm* base) {
         using namespace Utilities::FunctionsSkyrim::DynamicForm;
-        fake->Copy(base);
-        auto weaponBaseForm = base->As<RE::TESObjectWEAP>();
+        if (base->As<RE::TESObjectWEAP>() && fake->As<RE::TESObjectWEAP>()) _copy_weapon_fields(base, fake);
+        else if (base->As<RE::TESObjectBOOK>() && fake->As<RE::TESObjectBOOK>()) _copy_book_fields(base, fake);
+        else if (base->As<RE::TESAmmo>() && fake->As<RE::TESAmmo>()) _copy_ammo_fields(base, fake);
 
-        auto weaponNewForm = fake->As<RE::TESObjectWEAP>();
+        copyComponent<RE::TESDescription>(base, fake);
 
-        auto bookBaseForm = base->As<RE::TESObjectBOOK>();
+        copyComponent<RE::BGSKeywordForm>(base, fake);
 
-        auto bookNewForm = fake->As<RE::TESObjectBOOK>();
+        copyComponent<RE::BGSPickupPutdownSounds>(base, fake);
 
-        auto ammoBaseForm = base->As<RE::TESAmmo>();
+        copyComponent<RE::TESModelTextureSwap>(base, fake);
 
-        auto ammoNewForm = fake->As<RE::TESAmmo>();
+        copyComponent<RE::TESModel>(base, fake);
 
-        if (weaponNewForm && weaponBaseForm) {
-            weaponNewForm->firstPersonModelObject = weaponBaseForm->firstPersonModelObject;
+        copyComponent<RE::BGSMessageIcon>(base, fake);
 
-            weaponNewForm->weaponData = weaponBaseForm->weaponData;
+        copyComponent<RE::TESIcon>(base, fake);
 
-            weaponNewForm->criticalData = weaponBaseForm->criticalData;
+        copyComponent<RE::TESFullName>(base, fake);
 
-            weaponNewForm->attackSound = weaponBaseForm->attackSound;
+        copyComponent<RE::TESValueForm>(base, fake);
 
-            weaponNewForm->attackSound2D = weaponBaseForm->attackSound2D;
+        copyComponent<RE::TESWeightForm>(base, fake);
 
-            weaponNewForm->attackSound = weaponBaseForm->attackSound;
+        copyComponent<RE::BGSDestructibleObjectForm>(base, fake);
 
-            weaponNewForm->attackFailSound = weaponBaseForm->attackFailSound;
+        copyComponent<RE::TESEnchantableForm>(base, fake);
 
-            weaponNewForm->idleSound = weaponBaseForm->idleSound;
+        copyComponent<RE::BGSBlockBashData>(base, fake);
 
-            weaponNewForm->equipSound = weaponBaseForm->equipSound;
+        copyComponent<RE::BGSEquipType>(base, fake);
 
-            weaponNewForm->unequipSound = weaponBaseForm->unequipSound;
+        copyComponent<RE::TESAttackDamageForm>(base, fake);
 
-            weaponNewForm->soundLevel = weaponBaseForm->soundLevel;
+        copyComponent<RE::TESBipedModelForm>(base, fake);
+    }
 
-            weaponNewForm->impactDataSet = weaponBaseForm->impactDataSet;
+private:
+    static void _copy_weapon_fields(RE::TESForm* a_from, RE::TESForm* a_to) {
+        const auto* from = static_cast<RE::TESObjectWEAP*>(a_from);
+        auto* to = static_cast<RE::TESObjectWEAP*>(a_to);
 
-            weaponNewForm->templateWeapon = weaponBaseForm->templateWeapon;
+        to->firstPersonModelObject = from->firstPersonModelObject;
 
-            weaponNewForm->embeddedNode = weaponBaseForm->embeddedNode;
+        to->weaponData = from->weaponData;
 
-        } else if (bookBaseForm && bookNewForm) {
-            bookNewForm->data.flags = bookBaseForm->data.flags;
+        to->criticalData = from->criticalData;
 
-            bookNewForm->data.teaches.spell = bookBaseForm->data.teaches.spell;
+        to->attackSound = from->attackSound;
 
-            bookNewForm->data.teaches.actorValueToAdvance = bookBaseForm->data.teaches.actorValueToAdvance;
+        to->attackSound2D = from->attackSound2D;
 
-            bookNewForm->data.type = bookBaseForm->data.type;
+        to->attackSound = from->attackSound;
 
-            bookNewForm->inventoryModel = bookBaseForm->inventoryModel;
+        to->attackFailSound = from->attackFailSound;
 
-            bookNewForm->itemCardDescription = bookBaseForm->itemCardDescription;
+        to->idleSound = from->idleSound;
 
-        } else if (ammoBaseForm && ammoNewForm) {
-            ammoNewForm->GetRuntimeData().data.damage = ammoBaseForm->GetRuntimeData().data.damage;
+        to->equipSound = from->equipSound;
 
-            ammoNewForm->GetRuntimeData().data.flags = ammoBaseForm->GetRuntimeData().data.flags;
+        to->unequipSound = from->unequipSound;
 
-            ammoNewForm->GetRuntimeData().data.projectile = ammoBaseForm->GetRuntimeData().data.projectile;
-        }
-        /*else {
-            new_form->Copy(baseForm);
-        }*/
+        to->soundLevel = from->soundLevel;
 
-        copyComponent<RE::TESDescription>(base, fake);
+        to->impactDataSet = from->impactDataSet;
 
-        copyComponent<RE::BGSKeywordForm>(base, fake);
+        to->templateWeapon = from->templateWeapon;
 
-        copyComponent<RE::BGSPickupPutdownSounds>(base, fake);
+        to->embeddedNode = from->embeddedNode;
+    }
 
-        copyComponent<RE::TESModelTextureSwap>(base, fake);
+    static void _copy_book_fields(RE::TESForm* a_from, RE::TESForm* a_to) {
+        const auto* from = static_cast<RE::TESObjectBOOK*>(a_from);
+        auto* to = static_cast<RE::TESObjectBOOK*>(a_to);
 
-        copyComponent<RE::TESModel>(base, fake);
+        to->data.flags = from->data.flags;
 
-        copyComponent<RE::BGSMessageIcon>(base, fake);
+        to->data.teaches.spell = from->data.teaches.spell;
 
-        copyComponent<RE::TESIcon>(base, fake);
+        to->data.teaches.actorValueToAdvance = from->data.teaches.actorValueToAdvance;
 
-        copyComponent<RE::TESFullName>(base, fake);
+        to->data.type = from->data.type;
 
-        copyComponent<RE::TESValueForm>(base, fake);
+        to->inventoryModel = from->inventoryModel;
 
-        copyComponent<RE::TESWeightForm>(base, fake);
+        to->itemCardDescription = from->itemCardDescription;
+    }
 
-        copyComponent<RE::BGSDestructibleObjectForm>(base, fake);
+    static void _copy_ammo_fields(RE::TESForm* a_from, RE::TESForm* a_to) {
+        auto* from = static_cast<RE::TESAmmo*>(a_from);
+        auto* to = static_cast<RE::TESAmmo*>(a_to);
 
-        copyComponent<RE::TESEnchantableForm>(base, fake);
+        to->GetRuntimeData().data.damage = from->GetRuntimeData().data.damage;
 
-        copyComponent<RE::BGSBlockBashData>(base, fake);
+        to->GetRuntimeData().data.flags = from->GetRuntimeData().data.flags;
 
-        copyComponent<RE::BGSEquipType>(base, fake);
+        to->GetRuntimeData().data.projectile = from->GetRuntimeData().data.projectile;
+    }
+};
 
-        copyComponent<RE::TESAttackDamageForm>(base, fake);
+class DynamicFormTracker : public Utilities::DFSaveLoadData {
+    
+    // created form bank during the session. Create populates this.
+    std::unordered_map<BaseKey, std::set<FormID>, BaseKeyHash> forms;
+    std::map<FormID, uint32_t> customIDforms; // Fetch populates this
+    // reverse index of forms. generation is the load generation the form was last seen alive in the engine.
+    struct TrackedForm {
+        BaseKey base;
+        std::uint32_t generation;
+    };
+    std::unordered_map<FormID, TrackedForm> dynamic_bases;
+    std::uint32_t generation = 1;  // bumped by Reset on every load; older entries are revalidated lazily
+    std::vector<FormID> stale_queue;  // forms tracked at the last Reset, checked by RevalidateStale
+    std::size_t stale_cursor = 0;
+    std::unordered_map<BaseKey, std::unordered_map<uint32_t, FormID>, BaseKeyHash> customID_index; // (base, custom id) -> formid
 
-        copyComponent<RE::TESBipedModelForm>(base, fake);
+    std::set<FormID> active_forms; // _yield populates this
+    std::set<FormID> deleted_forms;
+    DynamicFormFlags flags;  // lock-free mirror of dynamic_bases and active_forms membership
+
+    // tracked forms that are alive but not active, per base. _yield takes from here, Create/load push.
+    struct PoolSlot {
+        BaseKey base;
+        std::size_t index;
+    };
+    std::unordered_map<BaseKey, std::vector<FormID>, BaseKeyHash> inactive_pool;
+    std::unordered_map<FormID, PoolSlot> pool_slots;
+    std::size_t pool_hits = 0;    // acquisitions served from the pool
+    std::size_t pool_misses = 0;  // acquisitions that had to create a new form
+
+    // DeleteInactives marks into here in one pass and sweeps from sweep_cursor, possibly over several frames
+    std::vector<std::pair<BaseKey, FormID>> pending_deletes;
+    std::size_t sweep_cursor = 0;
+    std::size_t n_swept = 0;
+
+
+    // Public calls that change the tracker take it exclusively, const queries shared. Private helpers expect it held.
+    // Lock order: mutex, then m_Lock.
+    mutable std::shared_mutex mutex;
+    const unsigned int form_limit = 10000;
+    std::atomic<bool> block_create = false;
+
+    //std::map<FormID,float> act_effs;
+    ActEffStore act_effs; // save file specific
+
+    // bases whose cached record blocks are out of date. Save re-encodes only those and reuses the rest.
+    std::unordered_set<BaseKey, BaseKeyHash> dirty_bases;
+    std::unordered_set<BaseKey, BaseKeyHash> acteff_bases;  // bases that had active effects at the last SendData
+    bool all_dirty = true;
+
+    // encoded v2 block per base, written to the cosave as is. m_Data is only used on load.
+    std::unordered_map<BaseKey, std::vector<std::uint8_t>, BaseKeyHash> record_blocks;
+    std::vector<Utilities::Types::DFSaveData> scratch_entries;
+
+    // Published for readers that should not wait on writers. Writers only mark them stale under the exclusive lock; the
+    // first reader after that rebuilds under the shared lock and cache_mutex and swaps in the new copy.
+    mutable std::mutex cache_mutex;
+
+    // GetSourceForms result, rebuilt only after a new base is added or act_effs changes
+    mutable std::atomic<std::shared_ptr<const std::vector<BaseKey>>> source_forms_cache{
+        std::make_shared<const std::vector<BaseKey>>()};
+    mutable std::atomic<bool> source_forms_dirty = true;
+
+    // immutable copy of customID_index for GetByCustomID, keyed by the editorid string so a lookup needs neither the
+    // lock nor m_EditorIDs. Bases are shared between snapshots; only those in custom_ids_dirty are copied anew.
+    struct CustomIDSnapshot {
+        struct Base {
+            std::string editorid;
+            std::shared_ptr<const std::unordered_map<uint32_t, FormID>> index;
+        };
+        std::unordered_map<FormID, std::vector<Base>> bases;  // base formid -> the bases with that formid
+    };
+    mutable std::atomic<std::shared_ptr<const CustomIDSnapshot>> custom_ids_snapshot{
+        std::make_shared<const CustomIDSnapshot>()};
+    mutable std::unordered_set<BaseKey, BaseKeyHash> custom_ids_dirty;  // bases changed since the snapshot
+    mutable std::atomic<bool> custom_ids_stale = false;
+
+    [[nodiscard]] const BaseKey _key(const FormID base_formid, const std::string_view base_editorid) {
+        return {base_formid, m_EditorIDs.Intern(base_editorid)};
+    }
+
+    // for read-only queries: does not intern, nullopt if no base with this editorid was ever tracked
+    [[nodiscard]] const std::optional<BaseKey> _find_key(const FormID base_formid, const std::string_view base_editorid) const {
+        if (const auto handle = m_EditorIDs.Find(base_editorid)) return BaseKey{base_formid, *handle};
+        return std::nullopt;
+    }
+
+    [[nodiscard]] RE::TESForm* _base_form(const BaseKey& base) const {
+        return Utilities::FunctionsSkyrim::GetFormByID(base.formid, m_EditorIDs.Get(base.editorid));
+    }
+
+    // the tracker reaches the form registry and the factories only through these two. They stay plain CommonLib
+    // calls; the host builds in tools/ link them against the stand-in registry and factories in tools/host.
+    template <class T = RE::TESForm>
+    [[nodiscard]] static T* _lookup(const FormID formid) {
+        if constexpr (std::is_same_v<T, RE::TESForm>) return RE::TESForm::LookupByID(formid);
+        else return RE::TESForm::LookupByID<T>(formid);
+    }
+
+    [[nodiscard]] static RE::IFormFactory* _factory(const RE::FormType type) {
+        return RE::IFormFactory::GetFormFactoryByType(type);
+    }
+
+    // inserting through here keeps source_forms_cache honest
+    std::set<FormID>& _formset(const BaseKey& base) {
+        const auto [it, inserted] = forms.try_emplace(base);
+        if (inserted) source_forms_dirty = true;
+        return it->second;
+    }
+
+    // these keep flags in sync with dynamic_bases and active_forms
+    void _track(const FormID dynamic_formid, const BaseKey& base) {
+        dynamic_bases[dynamic_formid] = {base, generation};
+        flags.Set(dynamic_formid, DynamicFormFlags::kTracked, true);
+    }
+
+    void _untrack(const FormID dynamic_formid) {
+        dynamic_bases.erase(dynamic_formid);
+        flags.Set(dynamic_formid, DynamicFormFlags::kTracked, false);
+    }
+
+    bool _activate(const FormID dynamic_formid) {
+        flags.Set(dynamic_formid, DynamicFormFlags::kActive, true);
+        return active_forms.insert(dynamic_formid).second;
+    }
+
+    void _deactivate(const FormID dynamic_formid) {
+        active_forms.erase(dynamic_formid);
+        flags.Set(dynamic_formid, DynamicFormFlags::kActive, false);
+    }
+
+    // drops a form that no longer exists from every index
+    void _forget(const BaseKey& base, const FormID dyn_formid) {
+        DFT_TRACE("Form with ID {:x} does not exist. Removing from formset.", dyn_formid);
+        if (const auto it = forms.find(base); it != forms.end()) it->second.erase(dyn_formid);
+        dirty_bases.insert(base);
+        _erase_custom_id(base, dyn_formid);
+        _deactivate(dyn_formid);
+        _pool_erase(dyn_formid);
+        _untrack(dyn_formid);
+    }
+
+    // true if the form is tracked and, when its stamp is from an earlier load, still alive as a form of its base
+    bool _validate(const FormID dyn_formid) {
+        const auto it = dynamic_bases.find(dyn_formid);
+        if (it == dynamic_bases.end()) return false;
+        auto& [base, form_generation] = it->second;
+        if (form_generation == generation) return true;
+        const auto* dyn_form = _lookup(dyn_formid);
+        const auto* base_form = _lookup(base.formid);
+        if (!dyn_form || !base_form || dyn_form->As<RE::TESObjectREFR>() ||
+            !_underlying_check(_signature(base_form), dyn_form)) {
+            _forget(base, dyn_formid);
+            return false;
+        }
+        form_generation = generation;
+        return true;
+    }
+
+    void _pool_push(const BaseKey& base, const FormID dynamic_formid) {
+        if (pool_slots.contains(dynamic_formid)) return;
+        auto& pool = inactive_pool[base];
+        pool_slots[dynamic_formid] = {base, pool.size()};
+        pool.push_back(dynamic_formid);
+    }
+
+    // swap-and-pop so removal stays O(1) regardless of pool size
+    void _pool_erase(const FormID dynamic_formid) {
+        const auto slot_it = pool_slots.find(dynamic_formid);
+        if (slot_it == pool_slots.end()) return;
+        const auto [base, index] = slot_it->second;
+        pool_slots.erase(slot_it);
+        auto& pool = inactive_pool[base];
+        if (index + 1 != pool.size()) {
+            pool[index] = pool.back();
+            pool_slots[pool[index]].index = index;
+        }
+        pool.pop_back();
+    }
+
+    void _rebuild_pools() {
+        inactive_pool.clear();
+        pool_slots.clear();
+        for (const auto& [base, formset] : forms) {
+            for (const auto dyn_formid : formset) {
+                if (!IsActive(dyn_formid)) _pool_push(base, dyn_formid);
+            }
+        }
+    }
+
+    // keeps customIDforms and customID_index in sync
+    void _set_custom_id(const BaseKey& base, const FormID dynamic_formid, const uint32_t custom_id) {
+        _erase_custom_id(base, dynamic_formid);
+        customIDforms[dynamic_formid] = custom_id;
+        customID_index[base][custom_id] = dynamic_formid;
+        dirty_bases.insert(base);
+        _custom_ids_changed(base);
+    }
+
+    void _erase_custom_id(const BaseKey& base, const FormID dynamic_formid) {
+        const auto it = customIDforms.find(dynamic_formid);
+        if (it == customIDforms.end()) return;
+        dirty_bases.insert(base);
+        _custom_ids_changed(base);
+        if (const auto base_it = customID_index.find(base); base_it != customID_index.end()) {
+            auto& index = base_it->second;
+            if (const auto it2 = index.find(it->second); it2 != index.end() && it2->second == dynamic_formid) {
+                index.erase(it2);
+            }
+        }
+        customIDforms.erase(it);
+    }
+
+    // the save entries of one formset into scratch_entries, in formid order
+    void _fill_entries(const std::set<FormID>& dyn_formset) {
+        scratch_entries.clear();
+        for (const auto dyn_formid : dyn_formset) {
+            const auto cid_it = customIDforms.find(dyn_formid);
+            const bool has_customid = cid_it != customIDforms.end();
+            scratch_entries.push_back(
+                {dyn_formid, {has_customid, has_customid ? cid_it->second : 0}, GetActiveEffectElapsed(dyn_formid)});
+        }
+    }
+
+	[[nodiscard]] const float GetActiveEffectElapsed(const FormID dyn_formid) const {
+        if (const auto* act_eff = act_effs.Find(dyn_formid)) return act_eff->elapsed;
+		return -1.f;
+	}
+
+
+    [[maybe_unused]] RE::TESForm* GetOGFormOfDynamic(const FormID dynamic_formid) {
+        if (const auto it = dynamic_bases.find(dynamic_formid); it != dynamic_bases.end()) {
+            return _base_form(it->second.base);
+        }
+		return nullptr;
+	}
+
+    // What reviving a form of one FormType takes, looked up once per type: its factory and the compiled copier
+    // FormReviver has for the type, nullptr for types it has none for.
+    struct RevivePlan {
+        RE::IFormFactory* factory = nullptr;
+        FormReviver::Copier revive = nullptr;
+    };
+    std::array<std::optional<RevivePlan>, 256> revive_plans;
+
+    RevivePlan& _revive_plan(const RE::FormType type) {
+        auto& plan = revive_plans[std::to_underlying(type)];
+        if (!plan) plan.emplace(_factory(type), FormReviver::Get(type));
+        return *plan;
+    }
+
+    void ReviveDynamicForm(RE::TESForm* fake, RE::TESForm* base, const FormID setFormID) {
+        DFT_PROFILE_SCOPE(kRevive);
+        fake->Copy(base);
+        const auto type = base->GetFormType();
+        if (const auto revive = type == fake->GetFormType() ? _revive_plan(type).revive : nullptr) revive(base, fake);
+        else FormReviver::ReviveByCasts(fake, base);
 
         if (setFormID != 0) fake->SetFormID(setFormID, false);
     }
@@ -176,14 +531,11 @@ class DynamicFormTracker : public Utilities::DFSaveLoadData {
     const FormID Create(T* baseForm, const RE::FormID setFormID = 0) {
         if (block_create) return 0;
 
-        //std::lock_guard<std::mutex> lock(mutex);
-
         if (!baseForm) {
             logger::error("Real form is null for baseForm.");
             return 0;
         }
 
-        const auto base_formid = baseForm->GetFormID();
         const auto base_editorid = clib_util::editorID::get_editorID(baseForm);
 
         if (base_editorid.empty()) {
@@ -191,9 +543,22 @@ class DynamicFormTracker : public Utilities::DFSaveLoadData {
 			return 0;
 		}
 
-        RE::TESForm* new_form = nullptr;
+        return _create(baseForm, _key(baseForm->GetFormID(), base_editorid),
+                       _revive_plan(baseForm->GetFormType()).factory, setFormID);
+    }
 
-        auto factory = RE::IFormFactory::GetFormFactoryByType(baseForm->GetFormType());
+    // the part of Create after the base has been resolved, so batch callers can do that once
+    const FormID _create(RE::TESForm* baseForm, const BaseKey& base, RE::IFormFactory* factory,
+                         const RE::FormID setFormID = 0) {
+        DFT_PROFILE_SCOPE(kCreate);
+        if (block_create) return 0;
+
+        if (!factory) {
+            logger::error("Failed to get form factory for baseForm.");
+            return 0;
+        }
+
+        RE::TESForm* new_form = nullptr;
 
         new_form = factory->Create();
 
@@ -203,56 +568,99 @@ class DynamicFormTracker : public Utilities::DFSaveLoadData {
             logger::error("Failed to create new form.");
             return 0;
         }
-        logger::trace("Original form id: {:x}", new_form->GetFormID());
+        DFT_TRACE("Original form id: {:x}", new_form->GetFormID());
 
-        if (forms[{base_formid, base_editorid}].contains(setFormID)) {
-        	logger::warn("Form with ID {:x} already exist for baseid {} and editorid {}.", setFormID, base_formid, base_editorid);
+        auto& formset = _formset(base);
+        if (formset.contains(setFormID)) {
+        	logger::warn("Form with ID {:x} already exist for baseid {} and editorid {}.", setFormID, base.formid, m_EditorIDs.Get(base.editorid));
             ReviveDynamicForm(new_form, baseForm, 0);
         } else ReviveDynamicForm(new_form, baseForm, setFormID);
 
         const auto new_formid = new_form->GetFormID();
 
-        logger::trace("Created form with type: {}, Base ID: {:x}, Name: {}",
+        DFT_TRACE("Created form with type: {}, Base ID: {:x}, Name: {}",
                       RE::FormTypeToString(new_form->GetFormType()), new_form->GetFormID(),new_form->GetName());
 
-        if (!forms[{base_formid, base_editorid}].insert(new_formid).second) {
+        if (!formset.insert(new_formid).second) {
             logger::error("Failed to insert new form into forms.");
-            _delete({base_formid, base_editorid}, new_formid);
+            _delete(base, new_formid);
             return 0;
         };
+        _track(new_formid, base);
+        _pool_push(base, new_formid);
+        dirty_bases.insert(base);
+        DFT_PROFILE_COUNT(kCreates);
 
         if (new_formid >= 0xFF3DFFFF){
             logger::critical("Dynamic FormID limit reached!!!!!!");
             block_create = true;
-			_delete({base_formid, base_editorid}, new_formid);
+            DFT_PROFILE_COUNT(kLimitTrips);
+			_delete(base, new_formid);
 			return 0;
         }
 
         return new_formid;
     }
 
-    const FormID GetByCustomID(const uint32_t custom_id, const FormID base_formid, std::string base_editorid) {
-        const auto formset = GetFormSet(base_formid, base_editorid);
-        if (formset.empty()) return 0;
-        for (const auto _formid : formset) {
-            if (customIDforms.contains(_formid) && customIDforms[_formid] == custom_id) return _formid;
-		}
-        return 0;
+    const FormID _get_by_custom_id(const uint32_t custom_id, const BaseKey& base) const {
+        const auto base_it = customID_index.find(base);
+        if (base_it == customID_index.end()) return 0;
+        const auto it = base_it->second.find(custom_id);
+        return it != base_it->second.end() ? it->second : 0;
     }
 
-    const bool IsActive(const FormID a_formid) {
-        return active_forms.contains(a_formid);
-	}
+    // exclusive lock held
+    void _custom_ids_changed(const BaseKey& base) {
+        custom_ids_dirty.insert(base);
+        custom_ids_stale.store(true, std::memory_order_release);
+    }
+
+    // shared lock and cache_mutex held. Copies the index of every changed base into a new snapshot.
+    void _publish_custom_ids() const {
+        auto next = std::make_shared<CustomIDSnapshot>(*custom_ids_snapshot.load());
+        for (const auto& base : custom_ids_dirty) {
+            const auto& editorid = m_EditorIDs.Get(base.editorid);
+            auto& entries = next->bases[base.formid];
+            auto entry = std::ranges::find(entries, editorid, &CustomIDSnapshot::Base::editorid);
+            const auto it = customID_index.find(base);
+            if (it == customID_index.end() || it->second.empty()) {
+                if (entry != entries.end()) entries.erase(entry);
+                if (entries.empty()) next->bases.erase(base.formid);
+                continue;
+            }
+            auto index = std::make_shared<const std::unordered_map<uint32_t, FormID>>(it->second);
+            if (entry != entries.end()) entry->index = std::move(index);
+            else entries.push_back({editorid, std::move(index)});
+        }
+        custom_ids_dirty.clear();
+        custom_ids_snapshot.store(std::move(next));
+        custom_ids_stale.store(false, std::memory_order_release);
+    }
+
+    [[nodiscard]] static FormID _get_by_custom_id(const CustomIDSnapshot& snapshot, const uint32_t custom_id,
+                                                  const FormID base_formid, const std::string_view base_editorid) {
+        const auto base_it = snapshot.bases.find(base_formid);
+        if (base_it == snapshot.bases.end()) return 0;
+        for (const auto& base : base_it->second) {
+            if (base.editorid != base_editorid) continue;
+            const auto it = base.index->find(custom_id);
+            return it != base.index->end() ? it->second : 0;
+        }
+        return 0;
+    }
 
     const RE::TESForm* _yield(const FormID dynamic_formid, RE::TESForm* base_form) {
-        if (auto newForm = RE::TESForm::LookupByID(dynamic_formid)) {
+        if (!_validate(dynamic_formid)) return nullptr;
+        if (auto newForm = _lookup(dynamic_formid)) {
             if (std::strlen(newForm->GetName()) == 0) {
                 ReviveDynamicForm(newForm, base_form, 0);
 			}
-            if (active_forms.insert(dynamic_formid).second) {
+            if (_activate(dynamic_formid)) {
+                _pool_erase(dynamic_formid);
                 if (active_forms.size()>form_limit) {
 					logger::warn("Active dynamic forms limit reached!!!");
                     block_create = true;
+                    DFT_PROFILE_COUNT(kLimitTrips);
 				}
             };
             
@@ -261,104 +669,195 @@ class DynamicFormTracker : public Utilities::DFSaveLoadData {
 		return nullptr;
 	}
 
-    void _delete(const std::pair<FormID, std::string> base, const FormID dynamic_formid) {
-        if (!forms.contains(base)) return;
-
-        if (auto newForm = RE::TESForm::LookupByID(dynamic_formid)) {
+    // O(1) reuse of an inactive form of this base, if there is one
+    const RE::TESForm* _yield_pooled(const BaseKey& base, RE::TESForm* base_form) {
+        const auto it = inactive_pool.find(base);
+        if (it == inactive_pool.end()) return nullptr;
+        auto& pool = it->second;
+        while (!pool.empty()) {
+            const auto dyn_formid = pool.back();
+            if (const auto dyn_form = _yield(dyn_formid, base_form)) {
+                pool_hits++;
+                DFT_PROFILE_COUNT(kPoolHits);
+                return dyn_form;
+            }
+            _pool_erase(dyn_formid);  // stale, _yield has already forgotten it
+        }
+        return nullptr;
+    }
 
-            if (auto bound_temp = newForm->As<RE::TESBoundObject>(); bound_temp) {
-                auto player = RE::PlayerCharacter::GetSingleton();
-                auto player_inventory = player->GetInventory();
-                if (auto it = player_inventory.find(bound_temp); it != player_inventory.end()) {
-                    player->RemoveItem(bound_temp, it->second.first, RE::ITEM_REMOVE_REASON::kRemove, nullptr, nullptr);
-                }
-			}
+    void _delete(const BaseKey base, const FormID dynamic_formid) {
+        const std::pair<BaseKey, FormID> target{base, dynamic_formid};
+        if (_delete_batch({&target, 1})) logger::debug("Deleted form {:x}.", dynamic_formid);
+    }
 
-            //if (auto* virtualMachine = RE::BSScript::Internal::VirtualMachine::GetSingleton()) {
-            //    auto* handlePolicy = virtualMachine->GetObjectHandlePolicy();
-            //    auto* bindPolicy = virtualMachine->GetObjectBindPolicy();
+    // Deletes many forms with a single snapshot of the player's inventory instead of one per form. Returns how many
+    // engine forms were deleted; callers log once per pass, not per form.
+    std::size_t _delete_batch(const std::span<const std::pair<BaseKey, FormID>> targets) {
+        if (targets.empty()) return 0;
+        DFT_PROFILE_SCOPE(kDelete);
+
+        std::vector<std::pair<const std::pair<BaseKey, FormID>*, RE::TESForm*>> resolved;
+        resolved.reserve(targets.size());
+        std::unordered_set<RE::TESBoundObject*> bound_targets;
+        for (const auto& target : targets) {
+            if (!forms.contains(target.first)) continue;
+            auto* newForm = _lookup(target.second);
+            resolved.emplace_back(&target, newForm);
+            if (!newForm) continue;
+            if (auto bound_temp = newForm->As<RE::TESBoundObject>(); bound_temp) bound_targets.insert(bound_temp);
+        }
 
-            //    if (handlePolicy && bindPolicy) {
-            //        auto newHandler = handlePolicy->GetHandleForObject(newForm->GetFormType(), newForm);
+        if (!bound_targets.empty()) {
+            auto player = RE::PlayerCharacter::GetSingleton();
+            const auto player_inventory = player->GetInventory(
+                [&bound_targets](RE::TESBoundObject& a_object) { return bound_targets.contains(&a_object); });
+            for (const auto& [bound_temp, entry] : player_inventory) {
+                player->RemoveItem(bound_temp, entry.first, RE::ITEM_REMOVE_REASON::kRemove, nullptr, nullptr);
+            }
+        }
 
-            //        if (newHandler != handlePolicy->EmptyHandle()) {
-            //            auto* vm_scripts_hashmap = &virtualMachine->attachedScripts;
-            //            auto newHandlerScripts_it = vm_scripts_hashmap->find(newHandler);
+        std::size_t n_deleted = 0;
+        for (const auto& [target, newForm] : resolved) {
+            const auto& [base, dynamic_formid] = *target;
+            if (newForm) {
+                //if (auto* virtualMachine = RE::BSScript::Internal::VirtualMachine::GetSingleton()) {
+                //    auto* handlePolicy = virtualMachine->GetObjectHandlePolicy();
+                //    auto* bindPolicy = virtualMachine->GetObjectBindPolicy();
+
+                //    if (handlePolicy && bindPolicy) {
+                //        auto newHandler = handlePolicy->GetHandleForObject(newForm->GetFormType(), newForm);
+
+                //        if (newHandler != handlePolicy->EmptyHandle()) {
+                //            auto* vm_scripts_hashmap = &virtualMachine->attachedScripts;
+                //            auto newHandlerScripts_it = vm_scripts_hashmap->find(newHandler);
+
+                //            if (newHandlerScripts_it != vm_scripts_hashmap->end()) {
+                //                vm_scripts_hashmap[newHandler].clear();
+                //            }
+                //        }
+                //    }
+                //}
+                delete newForm;
+                deleted_forms.insert(dynamic_formid);
+                n_deleted++;
+                DFT_PROFILE_COUNT(kDeletes);
+            }
 
-            //            if (newHandlerScripts_it != vm_scripts_hashmap->end()) {
-            //                vm_scripts_hashmap[newHandler].clear();
-            //            }
-            //        }
-            //    }
-            //}
-            logger::warn("Deleting form with ID: {:x}", dynamic_formid);
-            delete newForm;
-            deleted_forms.insert(dynamic_formid);
+            if (const auto it = forms.find(base); it != forms.end()) it->second.erase(dynamic_formid);
+            dirty_bases.insert(base);
+            _erase_custom_id(base, dynamic_formid);
+            _deactivate(dynamic_formid);
+            _pool_erase(dynamic_formid);
+            _untrack(dynamic_formid);
         }
-
-        forms[base].erase(dynamic_formid);
-        customIDforms.erase(dynamic_formid);
-        active_forms.erase(dynamic_formid);
+        return n_deleted;
     }
 
-    [[nodiscard]] const bool _underlying_check(const RE::TESForm* underlying, const RE::TESForm* derivative) const {
-        if (underlying->GetFormType() != derivative->GetFormType()) {
-            logger::trace("Form types do not match.");
-            return false;
+    void _revalidate(const std::chrono::steady_clock::duration budget) {
+        const auto start = std::chrono::steady_clock::now();
+        std::size_t n_checked = 0;
+        while (stale_cursor < stale_queue.size()) {
+            _validate(stale_queue[stale_cursor++]);
+            if (++n_checked % 64 == 0 && std::chrono::steady_clock::now() - start >= budget) break;
         }
-
-        // alchemy
-        const auto alch_underlying = underlying->As<RE::AlchemyItem>();
-        const auto alch_derivative = derivative->As<RE::AlchemyItem>();
-        bool asd1 = alch_underlying != nullptr;
-        bool asd2 = alch_derivative != nullptr;
-        if (const int asd = asd1 + asd2; asd % 2 != 0) {
-            logger::trace("Alchemy status does not match.");
-            return false;
+        if (stale_cursor >= stale_queue.size()) {
+            stale_queue.clear();
+            stale_cursor = 0;
         }
+    }
 
-        if (alch_underlying && alch_derivative) {
-            if (alch_underlying->IsPoison() != alch_derivative->IsPoison()) {
-                logger::trace("Poison status does not match.");
-                return false;
-            }
-
-            if (alch_underlying->IsFood() != alch_derivative->IsFood()) {
-                logger::trace("Food status does not match.");
-                return false;
+    void _mark_inactives() {
+        pending_deletes.clear();
+        sweep_cursor = 0;
+        n_swept = 0;
+        for (const auto& [base, formset] : forms) {
+            for (const auto dyn_formid : formset) {
+                if (!IsActive(dyn_formid)) pending_deletes.emplace_back(base, dyn_formid);
             }
+        }
+    }
 
-            if (alch_underlying->IsMedicine() != alch_derivative->IsMedicine()) {
-                logger::trace("Medicine status does not match.");
-                return false;
+    // batch_size bounds how much engine work happens between two budget checks
+    void _sweep_inactives(const std::chrono::steady_clock::duration budget, const size_t batch_size = SIZE_MAX) {
+        const auto start = std::chrono::steady_clock::now();
+        std::vector<std::pair<BaseKey, FormID>> batch;
+        std::size_t n_deleted = 0;
+        while (sweep_cursor < pending_deletes.size()) {
+            batch.clear();
+            while (sweep_cursor < pending_deletes.size() && batch.size() < batch_size) {
+                const auto [base, dyn_formid] = pending_deletes[sweep_cursor++];
+                // may have been fetched or deleted since it was marked. stale forms that are gone are only forgotten.
+                if (const auto it = dynamic_bases.find(dyn_formid); it != dynamic_bases.end() &&
+                    it->second.base == base && !IsActive(dyn_formid) && _validate(dyn_formid)) {
+                    batch.emplace_back(base, dyn_formid);
+                }
             }
+            n_deleted += _delete_batch(batch);
+            n_swept += batch.size();
+            if (std::chrono::steady_clock::now() - start >= budget) break;
         }
-
-        // ingredient
-        const auto ingr_underlying = underlying->As<RE::IngredientItem>();
-        const auto ingr_derivative = derivative->As<RE::IngredientItem>();
-        asd1 = ingr_underlying != nullptr;
-        asd2 = ingr_derivative != nullptr;
-        if (const int asd = asd1 + asd2; asd % 2 != 0) {
-            logger::trace("Ingredient status does not match.");
-            return false;
+        const auto elapsed =
+            std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+        logger::debug("Swept {} inactive forms in {} us, {} still to check.", n_deleted, elapsed.count(),
+                      pending_deletes.size() - sweep_cursor);
+        if (sweep_cursor >= pending_deletes.size()) {
+            pending_deletes.clear();
+            sweep_cursor = 0;
         }
+    }
 
-        if (ingr_underlying && ingr_derivative) {
-            if (ingr_underlying->IsFood() != ingr_derivative->IsFood()) {
-                logger::trace("Food status does not match.");
-                return false;
-            }
+    // what _underlying_check compares. Taken once per base on load instead of per dynamic form.
+    struct FormSignature {
+        RE::FormType type = RE::FormType::None;
+        bool is_alch = false;
+        bool is_ingr = false;
+        bool poison = false;
+        bool food = false;
+        bool medicine = false;
+    };
 
-            if (ingr_underlying->IsPoison() != ingr_derivative->IsPoison()) {
-                logger::trace("Poison status does not match.");
-                return false;
-            }
+    [[nodiscard]] static FormSignature _signature(const RE::TESForm* form) {
+        FormSignature signature{form->GetFormType()};
+        if (const auto alch = form->As<RE::AlchemyItem>()) {
+            signature.is_alch = true;
+            signature.poison = alch->IsPoison();
+            signature.food = alch->IsFood();
+            signature.medicine = alch->IsMedicine();
+        } else if (const auto ingr = form->As<RE::IngredientItem>()) {
+            signature.is_ingr = true;
+            signature.poison = ingr->IsPoison();
+            signature.food = ingr->IsFood();
+            signature.medicine = ingr->IsMedicine();
+        }
+        return signature;
+    }
 
-            if (ingr_underlying->IsMedicine() != ingr_derivative->IsMedicine()) {
-                logger::trace("Medicine status does not match.");
-                return false;
-            }
+    [[nodiscard]] static bool _underlying_check(const FormSignature& underlying, const RE::TESForm* derivative) {
+        const auto signature = _signature(derivative);
+        if (underlying.type != signature.type) {
+            DFT_TRACE("Form types do not match.");
+            return false;
+        }
+        if (underlying.is_alch != signature.is_alch) {
+            DFT_TRACE("Alchemy status does not match.");
+            return false;
+        }
+        if (underlying.is_ingr != signature.is_ingr) {
+            DFT_TRACE("Ingredient status does not match.");
+            return false;
+        }
+        if (underlying.poison != signature.poison) {
+            DFT_TRACE("Poison status does not match.");
+            return false;
+        }
+        if (underlying.food != signature.food) {
+            DFT_TRACE("Food status does not match.");
+            return false;
+        }
+        if (underlying.medicine != signature.medicine) {
+            DFT_TRACE("Medicine status does not match.");
+            return false;
         }
 
         // TODO ergnzen as you enable other modules
@@ -366,6 +865,30 @@ class DynamicFormTracker : public Utilities::DFSaveLoadData {
         return true;
     }
 
+    [[nodiscard]] std::ranges::subrange<std::set<FormID>::const_iterator> _get_formset(const BaseKey& base) const {
+        if (const auto it = forms.find(base); it != forms.end()) return it->second;
+        return {};
+    }
+
+    [[nodiscard]] std::size_t _n_pooled(const BaseKey& base) const {
+        const auto it = inactive_pool.find(base);
+        return it != inactive_pool.end() ? it->second.size() : 0;
+    }
+
+    [[nodiscard]] std::size_t _n_pending_deletes() const { return pending_deletes.size() - sweep_cursor; }
+
+    void _print() const {
+        for (const auto& [base, formset] : forms) {
+			logger::info("---------------------Base formid: {:x}, EditorID: {}, pooled: {}---------------------", base.formid,
+                         m_EditorIDs.Get(base.editorid), _n_pooled(base));
+			for (const auto _formid : formset) {
+                const auto _form = Utilities::FunctionsSkyrim::GetFormByID(_formid);
+                const auto _name = _form ? _form->GetName() : "NULL";
+                logger::info("Dynamic formid: {:x} with name: {}", _formid, _name);
+			}
+		}
+    }
+
 public:
     static DynamicFormTracker* GetSingleton() {
         static DynamicFormTracker singleton;
@@ -374,120 +897,351 @@ public:
 
     const char* GetType() override { return "DynamicFormTracker"; }
 
+    // lock-free, safe from any thread
+    [[nodiscard]] bool IsTracked(const FormID dynamic_formid) const {
+        return flags.Test(dynamic_formid, DynamicFormFlags::kTracked);
+    }
+
+    [[nodiscard]] bool IsActive(const FormID dynamic_formid) const {
+        return flags.Test(dynamic_formid, DynamicFormFlags::kActive);
+    }
+
+    // Lock-free until custom ids change; the first lookup after that publishes a new snapshot under the shared lock.
+    const FormID GetByCustomID(const uint32_t custom_id, const FormID base_formid, const std::string& base_editorid) const {
+        if (custom_ids_stale.load(std::memory_order_acquire)) {
+            std::shared_lock lock(mutex);
+            std::lock_guard cache_lock(cache_mutex);
+            if (custom_ids_stale.load(std::memory_order_relaxed)) _publish_custom_ids();
+        }
+        return _get_by_custom_id(*custom_ids_snapshot.load(), custom_id, base_formid, base_editorid);
+    }
+
     void Delete(const FormID dynamic_formid) {
-		std::lock_guard<std::mutex> lock(mutex);
-		for (auto& [base, formset] : forms) {
-			if (formset.contains(dynamic_formid)) {
-				_delete(base, dynamic_formid);
-			}
-		}
+        TraceRecorder::Scope trace(TraceRecorder::Op::kDelete, 0, {}, dynamic_formid);
+		std::unique_lock lock(mutex);
+        if (const auto it = dynamic_bases.find(dynamic_formid); it != dynamic_bases.end()) {
+            const auto base = it->second.base;
+            _delete(base, dynamic_formid);
+        }
 	}
 
+    void Delete(const std::span<const FormID> dynamic_formids) {
+        TraceRecorder::Scope trace(TraceRecorder::Op::kDeleteMany, 0, {},
+                                   static_cast<std::uint32_t>(dynamic_formids.size()));
+        trace.Payload(dynamic_formids);
+        std::unique_lock lock(mutex);
+        std::vector<std::pair<BaseKey, FormID>> targets;
+        targets.reserve(dynamic_formids.size());
+        std::unordered_set<FormID> seen;  // a formid listed twice must not be deleted twice
+        for (const auto dynamic_formid : dynamic_formids) {
+            if (!seen.insert(dynamic_formid).second) continue;
+            if (const auto it = dynamic_bases.find(dynamic_formid); it != dynamic_bases.end()) {
+                targets.emplace_back(it->second.base, dynamic_formid);
+            }
+        }
+        const auto start = std::chrono::steady_clock::now();
+        const auto n_deleted = _delete_batch(targets);
+        const auto elapsed =
+            std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+        logger::debug("Deleted {} of {} forms in {} us.", n_deleted, dynamic_formids.size(), elapsed.count());
+    }
+
     void DeleteInactives() {
-		std::lock_guard<std::mutex> lock(mutex);
-        logger::trace("Deleting inactives.");
-        for (auto& [base, formset] : forms) {
-		    size_t index = 0;
-            while (index < formset.size()) {
-                auto it = formset.begin();
-                std::advance(it, index);
-                if (!IsActive(*it)) _delete(base, *it);
-                else index++;
-			}
-		}
+        TraceRecorder::Scope trace(TraceRecorder::Op::kDeleteInactives);
+		std::unique_lock lock(mutex);
+        DFT_TRACE("Deleting inactives.");
+        _mark_inactives();
+        _sweep_inactives(std::chrono::steady_clock::duration::max());
 	}
 
-    std::vector<std::pair<FormID, std::string>> GetSourceForms(){
-        std::set<std::pair<FormID, std::string>> source_forms;
+    // Incremental DeleteInactives. Marks all inactive forms on the first call, then deletes for at most budget per
+    // call. Returns the number of deletions still pending; call again (e.g. next frame) until it returns 0.
+    size_t DeleteInactives(const std::chrono::microseconds budget) {
+        TraceRecorder::Scope trace(TraceRecorder::Op::kDeleteInactives, 0, {},
+                                   static_cast<std::uint32_t>(budget.count()));
+        std::unique_lock lock(mutex);
+        if (sweep_cursor >= pending_deletes.size()) _mark_inactives();
+        _sweep_inactives(budget, 64);
+        return trace.Return(_n_pending_deletes());
+    }
+
+    // runs the incremental DeleteInactives once per frame until nothing is pending
+    void DeleteInactivesOverFrames(const std::chrono::microseconds budget) {
+        if (DeleteInactives(budget) == 0) {
+            std::shared_lock lock(mutex);
+            logger::info("Deleted {} inactive forms.", n_swept);
+            return;
+        }
+        SKSE::GetTaskInterface()->AddTask([this, budget]() { DeleteInactivesOverFrames(budget); });
+    }
+
+    // Revalidates the forms left stale by the last load for at most budget. Returns how many are still unchecked;
+    // call again (e.g. next frame) until it returns 0.
+    size_t RevalidateStale(const std::chrono::microseconds budget) {
+        TraceRecorder::Scope trace(TraceRecorder::Op::kRevalidateStale, 0, {},
+                                   static_cast<std::uint32_t>(budget.count()));
+        std::unique_lock lock(mutex);
+        _revalidate(budget);
+        return trace.Return(stale_queue.size() - stale_cursor);
+    }
+
+    void RevalidateOverFrames(const std::chrono::microseconds budget) {
+        if (RevalidateStale(budget) == 0) {
+            logger::info("Revalidated tracked forms after load.");
+            return;
+        }
+        SKSE::GetTaskInterface()->AddTask([this, budget]() { RevalidateOverFrames(budget); });
+    }
+
+    const size_t GetNPendingDeletes() const {
+        std::shared_lock lock(mutex);
+        return _n_pending_deletes();
+    }
+
+    // forms deleted so far by the current DeleteInactives pass, or by the last one once nothing is pending
+    const size_t GetNSwept() const {
+        std::shared_lock lock(mutex);
+        return n_swept;
+    }
+
+    // the published list, immutable and shared, so it stays valid after the lock is released and costs no copy
+    std::shared_ptr<const std::vector<BaseKey>> GetSourceForms() const {
+        std::shared_lock lock(mutex);
+        if (!source_forms_dirty.load(std::memory_order_acquire)) return source_forms_cache.load();
+
+        std::lock_guard cache_lock(cache_mutex);
+        if (!source_forms_dirty.load(std::memory_order_relaxed)) return source_forms_cache.load();
+        auto source_forms = std::make_shared<std::vector<BaseKey>>();
+        source_forms->reserve(forms.size() + act_effs.size());
 		for (const auto& [base, formset] : forms) {
-			source_forms.insert(base);
+			source_forms->push_back(base);
 		}
         for (const auto& act_eff : act_effs) {
-            const auto base_formid = act_eff.baseFormid;
-            const auto base_form = Utilities::FunctionsSkyrim::GetFormByID(base_formid);
-            if (!base_form) {
-				logger::error("Failed to get base form.");
-				continue;
-			}
-            const auto base_editorid = clib_util::editorID::get_editorID(base_form);
-            source_forms.insert({base_formid, base_editorid});
+            source_forms->push_back(act_eff.base);
 		}
+        std::ranges::sort(*source_forms);
+        const auto [first, last] = std::ranges::unique(*source_forms);
+        source_forms->erase(first, last);
+        source_forms_cache.store(source_forms);
+        source_forms_dirty.store(false, std::memory_order_release);
 
-        auto source_forms_vector = std::vector<std::pair<FormID, std::string>>(source_forms.begin(), source_forms.end());
+		return source_forms;
+    }
 
-		return source_forms_vector;
+    // strings are only resolved at the papyrus and serialization boundaries
+    // a copy, since interning from another thread may move the table's strings
+    std::string GetEditorID(const BaseKey& base) const {
+        std::shared_lock lock(mutex);
+        return m_EditorIDs.Get(base.editorid);
     }
 
     void EditCustomID(const FormID dynamic_formid, const uint32_t custom_id) {
-        if (customIDforms.contains(dynamic_formid)) customIDforms[dynamic_formid] = custom_id;
-        else if (IsTracked(dynamic_formid)) customIDforms.insert({dynamic_formid, custom_id});
+        TraceRecorder::Scope trace(TraceRecorder::Op::kEditCustomID, dynamic_formid, {}, custom_id);
+        std::unique_lock lock(mutex);
+        if (const auto it = dynamic_bases.find(dynamic_formid); it != dynamic_bases.end()) {
+            _set_custom_id(it->second.base, dynamic_formid, custom_id);
+        }
 	}
 
+    // EditCustomID for many forms under one lock. custom_ids[i] goes to dynamic_formids[i].
+    void EditCustomIDs(const std::span<const FormID> dynamic_formids, const std::span<const uint32_t> custom_ids) {
+        TraceRecorder::Scope trace(TraceRecorder::Op::kEditCustomIDs, 0, {},
+                                   static_cast<std::uint32_t>(dynamic_formids.size()));
+        if (dynamic_formids.size() != custom_ids.size()) {
+            logger::error("Expected {} custom ids, got {}.", dynamic_formids.size(), custom_ids.size());
+            return;
+        }
+        if (trace.IsRecording()) {
+            for (std::size_t i = 0; i < dynamic_formids.size(); ++i) {
+                trace.Payload(dynamic_formids[i]);
+                trace.Payload(custom_ids[i]);
+            }
+        }
+        std::unique_lock lock(mutex);
+        for (std::size_t i = 0; i < dynamic_formids.size(); ++i) {
+            if (const auto it = dynamic_bases.find(dynamic_formids[i]); it != dynamic_bases.end()) {
+                _set_custom_id(it->second.base, dynamic_formids[i], custom_ids[i]);
+            }
+        }
+    }
+
     // tries to fetch by custom id. regardless, returns formid if there is in the bank
-    const FormID Fetch(const FormID baseFormID, const std::string baseEditorID,
+    const FormID Fetch(const FormID baseFormID, const std::string& baseEditorID,
                              const std::optional<uint32_t> customID) {
+        TraceRecorder::Scope trace(TraceRecorder::Op::kFetch, baseFormID, baseEditorID);
+        trace.CustomID(customID);
+        DFT_PROFILE_SCOPE(kFetch);
+        DFT_PROFILE_COUNT(kFetches);
+        std::unique_lock lock(mutex);
         auto* base_form = Utilities::FunctionsSkyrim::GetFormByID(baseFormID, baseEditorID);
 
         if (!base_form) {
             logger::error("Failed to get base form.");
             return 0;
         }
+        trace.BaseType(base_form->GetFormType());
+
+        const auto base = _find_key(baseFormID, baseEditorID);
+        if (!base) return 0;
 
         if (customID.has_value()) {
-            const auto new_formid = GetByCustomID(customID.value(), baseFormID, baseEditorID);
-            if (const auto dyn_form = _yield(new_formid, base_form)) return dyn_form->GetFormID();
+            const auto new_formid = _get_by_custom_id(customID.value(), *base);
+            if (const auto dyn_form = _yield(new_formid, base_form)) return trace.Return(dyn_form->GetFormID());
         } 
-        if (const auto formset = GetFormSet(baseFormID, baseEditorID); !formset.empty()) {
-            for (const auto _formid : formset) {
-                if (IsActive(_formid)) continue;
-                if (const auto dyn_form = _yield(_formid, base_form)) return dyn_form->GetFormID();
-            }
-        }
+        if (const auto dyn_form = _yield_pooled(*base, base_form)) return trace.Return(dyn_form->GetFormID());
 
         return 0;
     }
 
     template <typename T>
-    const FormID FetchCreate(const FormID baseFormID, const std::string baseEditorID, const std::optional<uint32_t> customID) {
+    const FormID FetchCreate(const FormID baseFormID, const std::string& baseEditorID, const std::optional<uint32_t> customID) {
 
         // TODO merge with Fetch
+        TraceRecorder::Scope trace(TraceRecorder::Op::kFetchCreate, baseFormID, baseEditorID);
+        trace.CustomID(customID);
+        DFT_PROFILE_SCOPE(kFetch);
+        DFT_PROFILE_COUNT(kFetches);
+        std::unique_lock lock(mutex);
         auto* base_form = Utilities::FunctionsSkyrim::GetFormByID<T>(baseFormID, baseEditorID);
         
         if (!base_form) {
 			logger::error("Failed to get base form.");
 			return 0;
 		}
+        trace.BaseType(base_form->GetFormType());
+
+        const auto base = _key(baseFormID, baseEditorID);
 
         if (customID.has_value()) {
-            const auto new_formid = GetByCustomID(customID.value(), baseFormID, baseEditorID);
-            if (const auto dyn_form = _yield(new_formid, base_form)) return dyn_form->GetFormID();
-        }
-        else if (const auto formset = GetFormSet(baseFormID, baseEditorID); !formset.empty()) {
-		    for (const auto _formid : formset) {
-                if (IsActive(_formid)) continue;
-                if (const auto dyn_form = _yield(_formid, base_form)) return dyn_form->GetFormID();
-                //else if (!Utilities::FunctionsSkyrim::GetFormByID(_formid)) Delete({baseFormID, baseEditorID}, _formid);
-		    }
+            const auto new_formid = _get_by_custom_id(customID.value(), base);
+            if (const auto dyn_form = _yield(new_formid, base_form)) return trace.Return(dyn_form->GetFormID());
         }
+        else if (const auto dyn_form = _yield_pooled(base, base_form)) return trace.Return(dyn_form->GetFormID());
 
-
+        pool_misses++;
+        DFT_PROFILE_COUNT(kPoolMisses);
         if (const auto dyn_form = _yield(Create<T>(base_form), base_form)) {
             const auto new_formid = dyn_form->GetFormID();
-            if (customID.has_value()) customIDforms[new_formid] = customID.value();
-            return new_formid;
+            if (customID.has_value()) _set_custom_id(base, new_formid, customID.value());
+            return trace.Return(new_formid);
         }
 
         return 0;
     }
 
+    // Fetch for count forms of one base under one lock; never creates. If customIDs is not empty it must hold count
+    // entries and each falls back to the pool like Fetch does. Forms that cannot be had are 0 in the result.
+    std::vector<FormID> FetchMany(const FormID baseFormID, const std::string& baseEditorID, const std::size_t count,
+                                  const std::span<const std::optional<uint32_t>> customIDs = {}) {
+        TraceRecorder::Scope trace(TraceRecorder::Op::kFetchMany, baseFormID, baseEditorID,
+                                   static_cast<std::uint32_t>(count));
+        std::vector<FormID> result;
+        if (!customIDs.empty() && customIDs.size() != count) {
+            logger::error("Expected {} custom ids, got {}.", count, customIDs.size());
+            return result;
+        }
+        trace.CustomIDs(customIDs);
+
+        std::unique_lock lock(mutex);
+        auto* base_form = Utilities::FunctionsSkyrim::GetFormByID(baseFormID, baseEditorID);
+        if (!base_form) {
+            logger::error("Failed to get base form.");
+            return result;
+        }
+        trace.BaseType(base_form->GetFormType());
+        const auto base = _find_key(baseFormID, baseEditorID);
+        if (!base) return result;
+
+        result.resize(count, 0);
+        std::uint32_t n_fetched = 0;
+        for (std::size_t i = 0; i < count; ++i) {
+            const RE::TESForm* dyn_form = nullptr;
+            std::optional<uint32_t> customID;
+            if (!customIDs.empty()) customID = customIDs[i];
+            if (customID) dyn_form = _yield(_get_by_custom_id(*customID, *base), base_form);
+            if (!dyn_form) dyn_form = _yield_pooled(*base, base_form);
+            if (!dyn_form) continue;
+            result[i] = dyn_form->GetFormID();
+            n_fetched++;
+        }
+        trace.Result(n_fetched);
+        trace.Payload(result);
+        return result;
+    }
+
+    // Acquires count forms of one base in a single call. The base, its editorid and its form factory are resolved
+    // once; custom id matches are taken first, then pooled forms, and only the remainder is created.
+    // If customIDs is not empty it must hold count entries and result[i] is the form for customIDs[i]; an entry
+    // without a value is served like FetchCreate without a custom id.
+    // Acquisition stops at the first form that cannot be had (block_create, form_limit or the dynamic formid limit
+    // tripping), so on partial success the result holds the forms acquired so far and is shorter than count.
+    template <typename T>
+    std::vector<FormID> FetchCreateMany(const FormID baseFormID, const std::string& baseEditorID, const std::size_t count,
+                                        const std::span<const std::optional<uint32_t>> customIDs = {}) {
+        TraceRecorder::Scope trace(TraceRecorder::Op::kFetchCreateMany, baseFormID, baseEditorID,
+                                   static_cast<std::uint32_t>(count));
+        std::unique_lock lock(mutex);
+        std::vector<FormID> result;
+
+        if (!customIDs.empty() && customIDs.size() != count) {
+            logger::error("Expected {} custom ids, got {}.", count, customIDs.size());
+            return result;
+        }
+        trace.CustomIDs(customIDs);
+
+        auto* base_form = Utilities::FunctionsSkyrim::GetFormByID<T>(baseFormID, baseEditorID);
+        if (!base_form) {
+            logger::error("Failed to get base form.");
+            return result;
+        }
+        trace.BaseType(base_form->GetFormType());
+
+        const auto base_editorid = clib_util::editorID::get_editorID(base_form);
+        if (base_editorid.empty()) {
+            logger::error("Failed to get editorID for baseForm.");
+            return result;
+        }
+        const auto base = _key(base_form->GetFormID(), base_editorid);
+        auto* factory = _revive_plan(base_form->GetFormType()).factory;
+
+        result.reserve(count);
+        for (std::size_t i = 0; i < count; ++i) {
+            const RE::TESForm* dyn_form = nullptr;
+            std::optional<uint32_t> customID;
+            if (!customIDs.empty()) customID = customIDs[i];
+            if (customID) dyn_form = _yield(_get_by_custom_id(*customID, base), base_form);
+            else dyn_form = _yield_pooled(base, base_form);
+
+            if (!dyn_form) {
+                pool_misses++;
+                DFT_PROFILE_COUNT(kPoolMisses);
+                dyn_form = _yield(_create(base_form, base, factory), base_form);
+                if (dyn_form && customID) _set_custom_id(base, dyn_form->GetFormID(), *customID);
+            }
+
+            if (!dyn_form) {
+                logger::warn("Acquired {} of {} forms for base {}.", i, count, base_editorid);
+                break;
+            }
+            result.push_back(dyn_form->GetFormID());
+        }
+
+        trace.Result(static_cast<std::uint32_t>(result.size()));
+        trace.Payload(result);
+        return result;
+    }
+
     [[maybe_unused]] void ReviveAll() {
+        std::unique_lock lock(mutex);
         for (const auto& [base, formset] : forms) {
-            auto* base_form = Utilities::FunctionsSkyrim::GetFormByID(base.first, base.second);
+            auto* base_form = _base_form(base);
             if (!base_form) {
                 logger::error("Failed to get base form.");
                 continue;
             }
-            for (const auto _formid : formset) {
+            // _yield forgets stale forms, which erases them from this very formset
+            const std::vector<FormID> formids(formset.begin(), formset.end());
+            for (const auto _formid : formids) {
                 if (const auto dyn_form = _yield(_formid, base_form)) {
                     logger::info("Revived form with ID: {:x}", dyn_form->GetFormID());
                 }
@@ -495,183 +1249,374 @@ public:
         }
     }
 
-    const std::set<FormID> GetFormSet(const FormID base_formid, std::string base_editorid = "") {
-        if (base_editorid.empty()) {
-            base_editorid = Utilities::FunctionsSkyrim::GetEditorID(base_formid);
-            if (base_editorid.empty()) {
-                return {};
-            }
-        }
-        const std::pair<FormID, std::string> key = {base_formid, base_editorid};
-        if (forms.contains(key)) return forms[key];
-        return {};
+    // Calls fn with each formid of the base's formset, in order, under the shared lock and without copying the set.
+    // fn must not call back into the tracker, other than the lock-free IsTracked/IsActive.
+    template <class Fn>
+    void ForEachInFormSet(const BaseKey& base, Fn&& fn) const {
+        std::shared_lock lock(mutex);
+        for (const auto formid : _get_formset(base)) fn(formid);
+    };
+
+    template <class Fn>
+    void ForEachInFormSet(const FormID base_formid, const std::string& base_editorid, Fn&& fn) const {
+        const auto editorid = base_editorid.empty() ? Utilities::FunctionsSkyrim::GetEditorID(base_formid) : base_editorid;
+        if (editorid.empty()) return;
+        std::shared_lock lock(mutex);
+        const auto base = _find_key(base_formid, editorid);
+        if (!base) return;
+        for (const auto formid : _get_formset(*base)) fn(formid);
     };
 
-    const size_t GetNDeleted() {
+    // Appends the formsets of all bases to out under one shared lock and returns how many each contributed.
+    // For callers that need the formids after the lock is released; out can be reused across calls.
+    std::vector<std::size_t> CopyFormSets(const std::span<RE::TESForm* const> base_forms, std::vector<FormID>& out) const {
+        std::vector<std::string> editorids;
+        editorids.reserve(base_forms.size());
+        for (const auto* base_form : base_forms) {
+            editorids.push_back(base_form ? clib_util::editorID::get_editorID(base_form) : std::string{});
+        }
+
+        std::vector<std::size_t> sizes(base_forms.size(), 0);
+        std::shared_lock lock(mutex);
+        for (std::size_t i = 0; i < base_forms.size(); ++i) {
+            if (editorids[i].empty()) continue;
+            const auto base = _find_key(base_forms[i]->GetFormID(), editorids[i]);
+            if (!base) continue;
+            const auto formset = _get_formset(*base);
+            const auto n_before = out.size();
+            out.insert(out.end(), formset.begin(), formset.end());
+            sizes[i] = out.size() - n_before;
+        }
+        return sizes;
+    }
+
+    const size_t GetNDeleted() const {
+        std::shared_lock lock(mutex);
 		return deleted_forms.size();
 	}
 
+    // number of inactive forms of this base that can be reused without creating a new one
+    const size_t GetNPooled(const BaseKey& base) const {
+        std::shared_lock lock(mutex);
+        return _n_pooled(base);
+    }
+
+    const std::pair<size_t, size_t> GetPoolHitsMisses() const {
+        std::shared_lock lock(mutex);
+        return {pool_hits, pool_misses};
+    }
+
+    // Creates inactive forms of the base until its pool holds reserve forms, creating at most max_create.
+    // Returns the number of forms created, so callers can spread the work over several frames.
+    size_t Prewarm(const std::string& baseEditorID, const size_t reserve, const size_t max_create = SIZE_MAX) {
+        TraceRecorder::Scope trace(TraceRecorder::Op::kPrewarm, 0, baseEditorID,
+                                   static_cast<std::uint32_t>(std::min<size_t>(reserve, UINT32_MAX)));
+        trace.Payload(static_cast<std::uint32_t>(std::min<size_t>(max_create, UINT32_MAX)));
+        auto* base_form = Utilities::FunctionsSkyrim::GetFormByID(0, baseEditorID);
+        if (!base_form) {
+            logger::error("Failed to get base form {} for prewarming.", baseEditorID);
+            return 0;
+        }
+        trace.BaseType(base_form->GetFormType());
+        const auto base_editorid = clib_util::editorID::get_editorID(base_form);
+        if (base_editorid.empty()) {
+            logger::error("Failed to get editorID for baseForm.");
+            return 0;
+        }
+        std::unique_lock lock(mutex);
+        const auto base = _key(base_form->GetFormID(), base_editorid);
+        auto* factory = _revive_plan(base_form->GetFormType()).factory;
+
+        size_t n_created = 0;
+        while (_n_pooled(base) < reserve && n_created < max_create) {
+            if (!_create(base_form, base, factory)) break;
+            n_created++;
+        }
+        return trace.Return(n_created);
+    }
+
     void SendData() {
-        // std::lock_guard<std::mutex> lock(mutex);
+        TraceRecorder::Scope trace(TraceRecorder::Op::kSendData);
+        DFT_PROFILE_SCOPE(kSendData);
+        std::unique_lock lock(mutex);
         logger::info("--------Sending data (DFT) ---------");
-        Clear();
 
-        act_effs.clear();
+        act_effs.Clear();
+        source_forms_dirty = true;
         auto act_eff_list = RE::PlayerCharacter::GetSingleton()->AsMagicTarget()->GetActiveEffectList();
 
         int n_act_effs = 0;
-        std::set<FormID> act_effs_temp;
         for (auto it = act_eff_list->begin(); it != act_eff_list->end(); ++it) {
             if (const auto* act_eff = *it){
                 const auto act_eff_formid = act_eff->spell->GetFormID();
                 if (active_forms.contains(act_eff_formid)) {
-                    if (act_effs_temp.contains(act_eff_formid)) logger::warn("Active effect already exists in act effs.");
-                    else n_act_effs++;
+                    const auto base_it = dynamic_bases.find(act_eff_formid);
+                    if (base_it == dynamic_bases.end()) continue;
                     bool has_customid = customIDforms.contains(act_eff_formid);
                     const uint32_t customid_temp = has_customid ? customIDforms[act_eff_formid] : 0;
-                    act_effs.push_back({GetOGFormOfDynamic(act_eff_formid)->GetFormID(),
-                                        act_eff_formid,
-                                        act_eff->elapsedSeconds,
-                                        {false, customid_temp}});
-                    act_effs_temp.insert(act_eff_formid);
+                    if (act_effs.Insert({base_it->second.base,
+                                         act_eff_formid,
+                                         act_eff->elapsedSeconds,
+                                         {false, customid_temp}})) n_act_effs++;
+                    else logger::warn("Active effect already exists in act effs.");
 				}
             }
         }
 
-        int n_fakes = 0;
-        for (const auto& [base_pair, dyn_formset] : forms) {
-            Utilities::Types::DFSaveDataLHS lhs({base_pair.first, base_pair.second});
-            Utilities::Types::DFSaveDataRHS rhs;
-			for (const auto dyn_formid : dyn_formset) {
-                if (!IsActive(dyn_formid)) logger::critical("Inactive form {:x} found in forms set.",dyn_formid);
-                const bool has_customid = customIDforms.contains(dyn_formid);
-                const uint32_t customid = has_customid ? customIDforms[dyn_formid] : 0;
-                const float act_eff_elpsd = GetActiveEffectElapsed(dyn_formid);
-                Utilities::Types::DFSaveData saveData({dyn_formid, {has_customid, customid}, act_eff_elpsd});
-                rhs.push_back(saveData);
-                n_fakes++;
-			}
-            if (!rhs.empty()) SetData(lhs, rhs);
-        }
+        // elapsed times move on every save, so bases with active effects now or at the last save are rebuilt
+        std::unordered_set<BaseKey, BaseKeyHash> new_acteff_bases;
+        for (const auto& act_eff : act_effs) new_acteff_bases.insert(act_eff.base);
+        dirty_bases.insert(acteff_bases.begin(), acteff_bases.end());
+        dirty_bases.insert(new_acteff_bases.begin(), new_acteff_bases.end());
+        acteff_bases = std::move(new_acteff_bases);
+
+        std::size_t n_fakes = 0;
+        for (const auto& dyn_formset : forms | std::views::values) n_fakes += dyn_formset.size();
 
         logger::info("Number of dynamic forms sent: {}", n_fakes);
+        logger::info("Bases to re-encode: {}", all_dirty ? forms.size() : dirty_bases.size());
+        logger::info("Pool hits: {}, pool misses: {}", pool_hits, pool_misses);
         logger::info("Number of active effects sent: {}", n_act_effs);
         logger::info("--------Data sent (DFT) ---------");
+        trace.Result(static_cast<std::uint32_t>(n_fakes));
+        TraceRecorder::GetSingleton()->Flush();
+        DFT_PROFILE_DUMP();
     };
 
+    // LoadV2/LoadV1 intern into m_EditorIDs, which the tracker reads and interns into under mutex. Taking it here
+    // keeps every access to the table under that one lock; m_Lock inside follows the usual order.
+    [[nodiscard]] bool Load(SKSE::SerializationInterface* serializationInterface, std::uint32_t version) override {
+        std::unique_lock lock(mutex);
+        return DFSaveLoadData::Load(serializationInterface, version);
+    }
+
+protected:
+    // the cached record blocks were encoded with the old setting
+    void OnCompressionChanged() override {
+        std::unique_lock lock(mutex);
+        all_dirty = true;
+    }
+
+    // streams the live formsets, so the bytes match what DFSaveLoadData::SaveV2 writes for the same records
+    [[nodiscard]] bool SaveV2(SKSE::SerializationInterface* serializationInterface) override {
+        assert(serializationInterface);
+        std::unique_lock lock(mutex);
+        _revalidate(std::chrono::steady_clock::duration::max());  // whatever the background pass has not reached yet
+
+        std::uint32_t numRecords = 0;
+        for (const auto& dyn_formset : forms | std::views::values) {
+            if (!dyn_formset.empty()) numRecords++;
+        }
+        if (!serializationInterface->WriteRecordData(numRecords)) {
+            logger::error("Failed to save {} data records", numRecords);
+            return false;
+        }
+
+        std::size_t rawSize = sizeof(numRecords);
+        std::size_t writtenSize = sizeof(numRecords);
+        int n_rebuilt = 0;
+        int n_reused = 0;
+        for (const auto& [base, dyn_formset] : forms) {
+            if (dyn_formset.empty()) {
+                record_blocks.erase(base);
+                continue;
+            }
+            auto& block = record_blocks[base];
+            const auto editorid = std::string_view(m_EditorIDs.Get(base.editorid));
+            if (all_dirty || dirty_bases.contains(base) || block.empty()) {
+                _fill_entries(dyn_formset);
+                EncodeBlock(block, base.formid, editorid, scratch_entries, m_CompressRecords);
+                n_rebuilt++;
+            } else n_reused++;
+            if (!WriteBlock(serializationInterface, block)) return false;
+            rawSize += RawBlockSize(editorid.size(), dyn_formset.size());
+            writtenSize += sizeof(std::uint32_t) + block.size();
+        }
+        dirty_bases.clear();
+        all_dirty = false;
+
+        logger::info("Saved {} data records: {} bytes written, {} bytes raw.", numRecords, writtenSize, rawSize);
+        logger::info("Bases re-encoded: {}, bases reused: {}", n_rebuilt, n_reused);
+        return true;
+    }
+
+    // the v1 layout, streamed from the live formsets like SaveV2. Bypasses the block cache.
+    [[nodiscard]] bool SaveV1(SKSE::SerializationInterface* serializationInterface) override {
+        assert(serializationInterface);
+        std::unique_lock lock(mutex);
+        _revalidate(std::chrono::steady_clock::duration::max());
+
+        std::size_t numRecords = 0;
+        for (const auto& dyn_formset : forms | std::views::values) {
+            if (!dyn_formset.empty()) numRecords++;
+        }
+        if (!serializationInterface->WriteRecordData(numRecords)) {
+            logger::error("Failed to save {} data records", numRecords);
+            return false;
+        }
+
+        for (const auto& [base, dyn_formset] : forms) {
+            if (dyn_formset.empty()) continue;
+            const std::uint32_t formid = base.formid;
+            const auto numRhsRecords = dyn_formset.size();
+            if (!serializationInterface->WriteRecordData(formid) ||
+                !Utilities::write_string(serializationInterface, m_EditorIDs.Get(base.editorid)) ||
+                !serializationInterface->WriteRecordData(numRhsRecords)) {
+                logger::error("Failed to save the header of the record for formid {:x}", formid);
+                return false;
+            }
+            _fill_entries(dyn_formset);
+            for (const auto& rhs_ : scratch_entries) {
+                if (!serializationInterface->WriteRecordData(rhs_)) {
+                    logger::error("Failed to save data");
+                    return false;
+                }
+            }
+        }
+        logger::info("Saved {} data records in the v1 layout.", numRecords);
+        return true;
+    }
+
+public:
+
     void ReceiveData() {
-        // std::lock_guard<std::mutex> lock(mutex);
+        TraceRecorder::Scope trace(TraceRecorder::Op::kReceiveData);
+        DFT_PROFILE_SCOPE(kReceiveData);
+        std::unique_lock lock(mutex);
 		logger::info("--------Receiving data (DFT) ---------");
 
+        // every distinct base editorid is resolved once, before the per-form pass
+        struct ResolvedBase {
+            FormID formid = 0;
+            std::optional<FormSignature> signature;
+        };
+        std::unordered_map<Utilities::Types::EditorIDHandle, ResolvedBase> resolved;
+        for (const auto& lhs : m_Data | std::views::keys) {
+            const auto [it, inserted] = resolved.try_emplace(lhs.editorid);
+            if (!inserted) continue;
+            if (const auto temp_form = Utilities::FunctionsSkyrim::GetFormByID(0, m_EditorIDs.Get(lhs.editorid))) {
+                it->second = {temp_form->GetFormID(), _signature(temp_form)};
+            } else logger::critical("Failed to get base form with editorid {}.", m_EditorIDs.Get(lhs.editorid));
+        }
+
         int n_fakes = 0;
         int n_act_effs = 0;
         for (const auto& [lhs, rhs] : m_Data) {
-            auto base_formid = lhs.first;
-            const auto& base_editorid = lhs.second;
-            const auto temp_form = Utilities::FunctionsSkyrim::GetFormByID(0, base_editorid);
-            if (!temp_form) logger::critical("Failed to get base form.");
-            else base_formid = temp_form->GetFormID();
+            const auto& [resolved_formid, signature] = resolved.at(lhs.editorid);
+            const BaseKey base{signature ? resolved_formid : lhs.formid, lhs.editorid};
+            const auto formset_it = forms.find(base);
+            std::set<FormID>* formset = formset_it != forms.end() ? &formset_it->second : nullptr;
             for (const auto& saveData : rhs) {
                 const auto dyn_formid = saveData.dyn_formid;
                 const auto [has_customid, customid] = saveData.custom_id;
                 const auto act_eff_elpsd = saveData.acteff_elapsed;
                 if (act_eff_elpsd >= 0.f) {
-                    act_effs.push_back({base_formid, dyn_formid, act_eff_elpsd, {has_customid, customid}});
-                    n_act_effs++;
+                    if (act_effs.Insert({base, dyn_formid, act_eff_elpsd, {has_customid, customid}})) n_act_effs++;
+                    source_forms_dirty = true;
                 }
-                if (const auto dyn_form = RE::TESForm::LookupByID(dyn_formid); !dyn_form) {
+                if (!signature) continue;
+                const auto dyn_form = _lookup(dyn_formid);
+                if (!dyn_form) {
                     logger::info("Dynamic form {:x} does not exist.", dyn_formid);
                     continue;
-                } else if (const auto dyn_form_ref = RE::TESForm::LookupByID<RE::TESObjectREFR>(dyn_formid)) {
+                } else if (dyn_form->As<RE::TESObjectREFR>()) {
                     logger::info("Dynamic form {:x} is a refr with name {}.", dyn_formid, dyn_form->GetName());
                     continue;
-                } else if (!_underlying_check(temp_form, dyn_form)) {
+                } else if (!_underlying_check(*signature, dyn_form)) {
                     // bcs load callback happens after the game loads, there is a chance that the game will assign new
                     // stuff to "previously" our dynamic formid especially for stuff like dynamic food which is not
                     // serialized by the game
-                    logger::trace("Underlying check failed for dynamic form {:x} with name {}.", dyn_formid,
+                    DFT_TRACE("Underlying check failed for dynamic form {:x} with name {}.", dyn_formid,
                                   dyn_form->GetName());
                     continue;
                 }
-                if (forms.contains({base_formid, base_editorid}) &&
-                    forms[{base_formid, base_editorid}].contains(dyn_formid)) {
-                    logger::trace("Form with ID {:x} already exist for baseid {} and editorid {}.", dyn_formid,
-                                 base_formid, base_editorid);
+                if (!formset) formset = &_formset(base);
+                if (!formset->insert(dyn_formid).second) {
+                    DFT_TRACE("Form with ID {:x} already exist for baseid {} and editorid {}.", dyn_formid,
+                                 base.formid, m_EditorIDs.Get(lhs.editorid));
                 }
-				else if (!forms[{base_formid, base_editorid}].insert(dyn_formid).second) {
-					logger::error("Failed to insert new form into forms.");
-					continue;
-				}
-				if (has_customid) customIDforms[dyn_formid] = customid;
+                _track(dyn_formid, base);
+				if (has_customid) _set_custom_id(base, dyn_formid, customid);
+                if (!IsActive(dyn_formid)) _pool_push(base, dyn_formid);
                 n_fakes++;
 			}
 		}
 
+        all_dirty = true;
+        Clear();  // loaded records now live in the tracker
+
+        trace.Result(static_cast<std::uint32_t>(n_fakes));
         logger::info("Number of dynamic forms received: {}", n_fakes);
         logger::info("Number of active effects received: {}", n_act_effs);
         // need to check if formids and editorids are valid
-#ifndef NDEBUG
-        Print();
-#endif  // !NDEBUG
+#if DFT_LOG_LEVEL <= SPDLOG_LEVEL_TRACE
+        _print();
+#endif
 
         logger::info("--------Data received (DFT) ---------");
 
 	};
 
     void Reset() {
-		// std::lock_guard<std::mutex> lock(mutex);
+        TraceRecorder::Scope trace(TraceRecorder::Op::kReset);
+        std::unique_lock lock(mutex);
 		//forms.clear();
-        CleanseFormsets();
+        // no engine lookups here: everything tracked so far becomes stale and is revalidated on first use or by
+        // RevalidateStale
+        generation++;
+        stale_queue.clear();
+        stale_cursor = 0;
+        stale_queue.reserve(dynamic_bases.size());
+        for (const auto dyn_formid : dynamic_bases | std::views::keys) stale_queue.push_back(dyn_formid);
 		customIDforms.clear();
+        customID_index.clear();
+        custom_ids_snapshot.store(std::make_shared<const CustomIDSnapshot>());
+        custom_ids_dirty.clear();
+        custom_ids_stale = false;
 		active_forms.clear();
+        flags.Clear(DynamicFormFlags::kActive);
+        _rebuild_pools();
 		//deleted_forms.clear();
-		act_effs.clear();
+		act_effs.Clear();
+        source_forms_dirty = true;
+        all_dirty = true;
         block_create = false;
 	};
 
-    void Print() {
-        for (const auto& [base, formset] : forms) {
-			logger::info("---------------------Base formid: {:x}, EditorID: {}---------------------", base.first, base.second);
-			for (const auto _formid : formset) {
-                const auto _form = Utilities::FunctionsSkyrim::GetFormByID(_formid);
-                const auto _name = _form ? _form->GetName() : "NULL";
-                logger::info("Dynamic formid: {:x} with name: {}", _formid, _name);
-			}
-		}
+    void Print() const {
+        std::shared_lock lock(mutex);
+        _print();
     }
 
+    // Re-casts the saved active effects the player no longer has and restores their elapsed time.
+    // The player's effect list is matched against a hash of the saved effects in one pass; after the casts a second
+    // pass patches only effects of the spells just cast, since CastSpellImmediate does not hand back the new effects.
     void ApplyMissingActiveEffects() {
+        DFT_PROFILE_SCOPE(kApplyMissingActiveEffects);
+        std::unique_lock lock(mutex);
+        const auto start = std::chrono::steady_clock::now();
 
-        std::map<FormID, float> new_act_effs; // terrible name
-        // i need to change the formids in act_effs if they are not valid to valid ones
-        for (auto it = act_effs.begin(); it != act_effs.end();++it) {
-            const auto elpsd = it->elapsed;
-            if (it->elapsed < 0.f) {
+        // saved effects by the formid they have now, custom ids resolved to the current form
+        std::unordered_map<FormID, float> missing;
+        missing.reserve(act_effs.size());
+        for (const auto& act_eff : act_effs) {
+            if (act_eff.elapsed < 0.f) {
 				logger::error("Elapsed time is negative. Removing from act effs.");
 				continue;
 			}
-            const auto& [has_cstmid, custom_id] = it->custom_id;
-            const auto base_mg_item = Utilities::FunctionsSkyrim::GetFormByID(it->baseFormid);
-            const auto dynamicFormid = it->dynamicFormid;
-            if (!base_mg_item) {
-				logger::error("Failed to get base form.");
-				continue;
-			}
-            if (!has_cstmid) {
-                new_act_effs[dynamicFormid] = elpsd;
-                continue;
-            }
-            const auto dyn_formid = GetByCustomID(custom_id, it->baseFormid, clib_util::editorID::get_editorID(base_mg_item));
+            const auto& [has_cstmid, custom_id] = act_eff.custom_id;
+            const auto dyn_formid = has_cstmid ? _get_by_custom_id(custom_id, act_eff.base) : act_eff.dynamicFormid;
             if (!dyn_formid) {
                 logger::error("Failed to get form by custom id. Removing from act effs.");
                 continue;
             }
-			new_act_effs[dyn_formid] = elpsd;
+			missing[dyn_formid] = act_eff.elapsed;
 		}
+        const auto n_saved = act_effs.size();
 
-        act_effs.clear();
-        if (new_act_effs.empty()) return;
-
+        act_effs.Clear();
+        source_forms_dirty = true;
+        if (missing.empty()) return;
 
         auto plyr = RE::PlayerCharacter::GetSingleton();
         auto mg_target = plyr->AsMagicTarget();
@@ -679,48 +1624,44 @@ public:
             logger::error("Failed to get player as magic target.");
             return;
         }
-        auto act_eff_list = mg_target->GetActiveEffectList();
-        for (auto it = act_eff_list->begin(); it != act_eff_list->end(); ++it) {
-            if (const auto* act_eff = *it) {
-                if (const auto mg_item = act_eff->spell) {
-                    const auto mg_item_formid = mg_item->GetFormID();
-                    if (new_act_effs.contains(mg_item_formid)) new_act_effs.erase(mg_item_formid);
-                }
-            }
+        auto* act_eff_list = mg_target->GetActiveEffectList();
+        for (const auto* act_eff : *act_eff_list) {
+            if (act_eff && act_eff->spell) missing.erase(act_eff->spell->GetFormID());
         }
+        if (missing.empty()) return;
 
         auto mg_caster = plyr->GetMagicCaster(RE::MagicSystem::CastingSource::kInstant);
         if (!mg_caster) {
             logger::error("Failed to get player as magic caster.");
             return;
         }
-        for (const auto& [item_formid, elapsed] : new_act_effs) {
-            auto* item = RE::TESForm::LookupByID<RE::MagicItem>(item_formid);
+        std::size_t n_cast = 0;
+        for (auto it = missing.begin(); it != missing.end();) {
+            auto* item = _lookup<RE::MagicItem>(it->first);
             if (!item) {
                 logger::error("Failed to get item by formid.");
+                it = missing.erase(it);
                 continue;
             }
             mg_caster->CastSpellImmediate(item, false, plyr, 1.0f, false, 0.0f, nullptr);
+            n_cast++;
+            ++it;
         }
 
-        // now i need to go to act eff list and adjust the elapsed time
+        // every effect of a spell just cast gets its elapsed time back
+        std::size_t n_patched = 0;
         act_eff_list = mg_target->GetActiveEffectList();
-        for (auto it = act_eff_list->begin(); it != act_eff_list->end(); ++it) {
-            if (auto* act_eff = *it) {
-                if (const auto mg_item = act_eff->spell) {
-                    const auto mg_item_formid = mg_item->GetFormID();
-                    if (new_act_effs.contains(mg_item_formid)) {
-                        if (act_eff->duration > new_act_effs[mg_item_formid]) {
-                            act_eff->elapsedSeconds = new_act_effs[mg_item_formid];
-                        } else {
-                            act_eff->elapsedSeconds = act_eff->duration - 1;
-                        }
-                        new_act_effs.erase(mg_item_formid);
-                    }
-                }
-            }
+        for (auto* act_eff : *act_eff_list) {
+            if (!act_eff || !act_eff->spell) continue;
+            const auto it = missing.find(act_eff->spell->GetFormID());
+            if (it == missing.end()) continue;
+            act_eff->elapsedSeconds = act_eff->duration > it->second ? it->second : act_eff->duration - 1;
+            n_patched++;
         }
 
+        const auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+        logger::info("Restored {} of {} saved active effects ({} effects patched) in {} us.", n_cast, n_saved,
+                     n_patched, elapsed.count());
     };
 };
 
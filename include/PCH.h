@@ -1,5 +1,6 @@
 #include "RE/Skyrim.h"
 #include "SKSE/SKSE.h"
+#include <spdlog/async.h>
 #include <spdlog/sinks/basic_file_sink.h>
 
 namespace logger = SKSE::log;
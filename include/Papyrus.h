@@ -0,0 +1,150 @@
+#pragma once
+
+#include "DynamicFormTracker.h"
+
+// Natives of the DynamicFormTracker script. The *Many variants cost one VM crossing and one tracker lock for the
+// whole array, so scripts should prefer them over loops. A negative custom id means none, also as an element of a
+// custom id array; an empty custom id array means none for every form. Counts and arrays past the Papyrus array limit
+// are refused, so a script cannot make one native hold the tracker lock over an unbounded batch.
+namespace Papyrus {
+
+    constexpr auto script_name = "DynamicFormTracker"sv;
+    constexpr std::size_t max_array_size = 128;
+
+    bool CheckArraySize(const std::string_view native, const std::string_view what, const std::size_t size) {
+        if (size <= max_array_size) return true;
+        logger::error("{}: {} {} exceeds the array limit of {}.", native, what, size, max_array_size);
+        return false;
+    }
+
+    std::vector<RE::TESForm*> ToForms(const std::vector<FormID>& formids) {
+        std::vector<RE::TESForm*> forms;
+        forms.reserve(formids.size());
+        for (const auto formid : formids) forms.push_back(formid ? RE::TESForm::LookupByID(formid) : nullptr);
+        return forms;
+    }
+
+    std::vector<FormID> ToFormIDs(const std::vector<RE::TESForm*>& forms) {
+        std::vector<FormID> formids;
+        formids.reserve(forms.size());
+        for (const auto* form : forms) {
+            if (form) formids.push_back(form->GetFormID());
+        }
+        return formids;
+    }
+
+    std::optional<uint32_t> ToCustomID(const std::int32_t customID) {
+        return customID < 0 ? std::nullopt : std::optional<uint32_t>(customID);
+    }
+
+    std::vector<std::optional<uint32_t>> ToCustomIDs(const std::vector<std::int32_t>& customIDs) {
+        std::vector<std::optional<uint32_t>> result;
+        result.reserve(customIDs.size());
+        for (const auto customID : customIDs) result.push_back(ToCustomID(customID));
+        return result;
+    }
+
+    std::string EditorID(const RE::TESForm* base) {
+        return base ? clib_util::editorID::get_editorID(base) : std::string{};
+    }
+
+    RE::TESForm* Fetch(RE::StaticFunctionTag*, RE::TESForm* base, const std::int32_t customID) {
+        if (!DFT || !base) return nullptr;
+        const auto formid = DFT->Fetch(base->GetFormID(), EditorID(base), ToCustomID(customID));
+        return formid ? RE::TESForm::LookupByID(formid) : nullptr;
+    }
+
+    std::vector<RE::TESForm*> FetchMany(RE::StaticFunctionTag*, RE::TESForm* base, const std::int32_t count,
+                                        std::vector<std::int32_t> customIDs) {
+        if (!DFT || !base || count <= 0) return {};
+        if (!CheckArraySize("FetchMany", "count", count) ||
+            !CheckArraySize("FetchMany", "custom ids", customIDs.size())) {
+            return {};
+        }
+        return ToForms(DFT->FetchMany(base->GetFormID(), EditorID(base), count, ToCustomIDs(customIDs)));
+    }
+
+    RE::TESForm* FetchCreate(RE::StaticFunctionTag*, RE::TESForm* base, const std::int32_t customID) {
+        if (!DFT || !base) return nullptr;
+        const auto formid =
+            DFT->FetchCreate<RE::TESBoundObject>(base->GetFormID(), EditorID(base), ToCustomID(customID));
+        return formid ? RE::TESForm::LookupByID(formid) : nullptr;
+    }
+
+    std::vector<RE::TESForm*> FetchCreateMany(RE::StaticFunctionTag*, RE::TESForm* base, const std::int32_t count,
+                                              std::vector<std::int32_t> customIDs) {
+        if (!DFT || !base || count <= 0) return {};
+        if (!CheckArraySize("FetchCreateMany", "count", count) ||
+            !CheckArraySize("FetchCreateMany", "custom ids", customIDs.size())) {
+            return {};
+        }
+        return ToForms(DFT->FetchCreateMany<RE::TESBoundObject>(base->GetFormID(), EditorID(base), count,
+                                                                ToCustomIDs(customIDs)));
+    }
+
+    void Delete(RE::StaticFunctionTag*, RE::TESForm* form) {
+        if (DFT && form) DFT->Delete(form->GetFormID());
+    }
+
+    void DeleteMany(RE::StaticFunctionTag*, std::vector<RE::TESForm*> forms) {
+        if (DFT) DFT->Delete(ToFormIDs(forms));
+    }
+
+    void EditCustomID(RE::StaticFunctionTag*, RE::TESForm* form, const std::int32_t customID) {
+        if (DFT && form && customID >= 0) DFT->EditCustomID(form->GetFormID(), customID);
+    }
+
+    void EditCustomIDs(RE::StaticFunctionTag*, std::vector<RE::TESForm*> forms, std::vector<std::int32_t> customIDs) {
+        if (!DFT) return;
+        if (forms.size() != customIDs.size()) {
+            logger::error("EditCustomIDs: {} forms but {} custom ids.", forms.size(), customIDs.size());
+            return;
+        }
+        std::vector<FormID> formids;
+        std::vector<uint32_t> ids;
+        for (std::size_t i = 0; i < forms.size(); ++i) {
+            if (!forms[i] || customIDs[i] < 0) continue;
+            formids.push_back(forms[i]->GetFormID());
+            ids.push_back(customIDs[i]);
+        }
+        DFT->EditCustomIDs(formids, ids);
+    }
+
+    std::vector<RE::TESForm*> GetFormSet(RE::StaticFunctionTag*, RE::TESForm* base) {
+        if (!DFT || !base) return {};
+        std::vector<FormID> formids;
+        DFT->CopyFormSets({&base, 1}, formids);
+        return ToForms(formids);
+    }
+
+    // all formsets back to back, in the order of bases. GetFormSetCounts gives where each one ends.
+    std::vector<RE::TESForm*> GetFormSets(RE::StaticFunctionTag*, std::vector<RE::TESForm*> bases) {
+        if (!DFT) return {};
+        std::vector<FormID> formids;
+        DFT->CopyFormSets(bases, formids);
+        return ToForms(formids);
+    }
+
+    std::vector<std::int32_t> GetFormSetCounts(RE::StaticFunctionTag*, std::vector<RE::TESForm*> bases) {
+        if (!DFT) return {};
+        std::vector<FormID> formids;
+        const auto sizes = DFT->CopyFormSets(bases, formids);
+        return {sizes.begin(), sizes.end()};
+    }
+
+    bool Register(RE::BSScript::IVirtualMachine* vm) {
+        vm->RegisterFunction("Fetch", script_name, Fetch);
+        vm->RegisterFunction("FetchMany", script_name, FetchMany);
+        vm->RegisterFunction("FetchCreate", script_name, FetchCreate);
+        vm->RegisterFunction("FetchCreateMany", script_name, FetchCreateMany);
+        vm->RegisterFunction("Delete", script_name, Delete);
+        vm->RegisterFunction("DeleteMany", script_name, DeleteMany);
+        vm->RegisterFunction("EditCustomID", script_name, EditCustomID);
+        vm->RegisterFunction("EditCustomIDs", script_name, EditCustomIDs);
+        vm->RegisterFunction("GetFormSet", script_name, GetFormSet);
+        vm->RegisterFunction("GetFormSets", script_name, GetFormSets);
+        vm->RegisterFunction("GetFormSetCounts", script_name, GetFormSetCounts);
+        logger::info("Registered {} papyrus functions.", script_name);
+        return true;
+    }
+};
@@ -0,0 +1,134 @@
+#pragma once
+
+#include <intrin.h>
+#include "Utils.h"
+
+// Cycle-counter latency histograms and event counters for the tracker hot paths.
+// Only compiled in with DFT_PROFILING (cmake -DDFT_PROFILING=ON); otherwise the DFT_PROFILE_* macros expand to nothing.
+namespace Profiling {
+
+    enum class Timer : std::uint8_t {
+        kRevive,
+        kCreate,
+        kFetch,
+        kDelete,
+        kSendData,
+        kReceiveData,
+        kApplyMissingActiveEffects,
+        kTotal
+    };
+
+    enum class Counter : std::uint8_t { kCreates, kFetches, kPoolHits, kPoolMisses, kDeletes, kLimitTrips, kTotal };
+
+    constexpr std::array<std::string_view, static_cast<std::size_t>(Timer::kTotal)> timer_names{
+        "ReviveDynamicForm", "Create", "Fetch", "Delete", "SendData", "ReceiveData", "ApplyMissingActiveEffects"};
+
+    constexpr std::array<std::string_view, static_cast<std::size_t>(Counter::kTotal)> counter_names{
+        "creates", "fetches", "pool hits", "pool misses", "deletes", "limit trips"};
+
+    // bucket i holds the samples of bit width i, i.e. [2^(i-1), 2^i) cycles
+    struct Histogram {
+        std::array<std::atomic<std::uint64_t>, 65> buckets{};
+        std::atomic<std::uint64_t> count = 0;
+        std::atomic<std::uint64_t> total = 0;
+        std::atomic<std::uint64_t> max = 0;
+
+        void Add(const std::uint64_t cycles) {
+            buckets[std::bit_width(cycles)].fetch_add(1, std::memory_order_relaxed);
+            count.fetch_add(1, std::memory_order_relaxed);
+            total.fetch_add(cycles, std::memory_order_relaxed);
+            auto prev = max.load(std::memory_order_relaxed);
+            while (prev < cycles && !max.compare_exchange_weak(prev, cycles, std::memory_order_relaxed)) {
+            }
+        }
+
+        // upper bound of the bucket the p-th sample falls in
+        [[nodiscard]] std::uint64_t Percentile(const double p) const {
+            const auto n = count.load(std::memory_order_relaxed);
+            if (!n) return 0;
+            const auto rank = static_cast<std::uint64_t>(std::ceil(p * static_cast<double>(n)));
+            std::uint64_t seen = 0;
+            for (std::size_t i = 0; i < buckets.size(); ++i) {
+                seen += buckets[i].load(std::memory_order_relaxed);
+                if (seen >= rank) return i ? (i < 64 ? (1ULL << i) - 1 : UINT64_MAX) : 0;
+            }
+            return max.load(std::memory_order_relaxed);
+        }
+
+        void Reset() {
+            for (auto& bucket : buckets) bucket.store(0, std::memory_order_relaxed);
+            count.store(0, std::memory_order_relaxed);
+            total.store(0, std::memory_order_relaxed);
+            max.store(0, std::memory_order_relaxed);
+        }
+    };
+
+    struct Stats {
+        std::array<Histogram, static_cast<std::size_t>(Timer::kTotal)> timers;
+        std::array<std::atomic<std::uint64_t>, static_cast<std::size_t>(Counter::kTotal)> counters{};
+
+        // tsc/steady_clock pair taken at startup, to turn cycles into time when dumping
+        const std::uint64_t tsc_origin = __rdtsc();
+        const std::chrono::steady_clock::time_point time_origin = std::chrono::steady_clock::now();
+    };
+
+    Stats stats;
+
+    inline void Count(const Counter counter, const std::uint64_t n = 1) {
+        stats.counters[static_cast<std::size_t>(counter)].fetch_add(n, std::memory_order_relaxed);
+    }
+
+    class ScopedTimer {
+    public:
+        explicit ScopedTimer(const Timer a_timer) : timer(a_timer), start(__rdtsc()) {}
+        ScopedTimer(const ScopedTimer&) = delete;
+        ScopedTimer& operator=(const ScopedTimer&) = delete;
+        ~ScopedTimer() { stats.timers[static_cast<std::size_t>(timer)].Add(__rdtsc() - start); }
+
+    private:
+        Timer timer;
+        std::uint64_t start;
+    };
+
+    [[nodiscard]] inline double CyclesPerMicrosecond() {
+        const auto us = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - stats.time_origin);
+        return us.count() > 0. ? static_cast<double>(__rdtsc() - stats.tsc_origin) / us.count() : 1.;
+    }
+
+    // writes every timer with samples and every counter to the plugin log
+    inline void Dump() {
+        const auto cycles_per_us = CyclesPerMicrosecond();
+        logger::info("--------Profile (DFT) ---------");
+        for (std::size_t i = 0; i < stats.timers.size(); ++i) {
+            const auto& histogram = stats.timers[i];
+            const auto n = histogram.count.load(std::memory_order_relaxed);
+            if (!n) continue;
+            const auto to_us = [cycles_per_us](const std::uint64_t cycles) {
+                return static_cast<double>(cycles) / cycles_per_us;
+            };
+            logger::info("{}: n {}, mean {:.1f} us, p50 <{:.1f} us, p99 <{:.1f} us, max {:.1f} us", timer_names[i], n,
+                         to_us(histogram.total.load(std::memory_order_relaxed)) / static_cast<double>(n),
+                         to_us(histogram.Percentile(0.5)), to_us(histogram.Percentile(0.99)),
+                         to_us(histogram.max.load(std::memory_order_relaxed)));
+        }
+        for (std::size_t i = 0; i < stats.counters.size(); ++i) {
+            logger::info("{}: {}", counter_names[i], stats.counters[i].load(std::memory_order_relaxed));
+        }
+        logger::info("--------Profile end (DFT) ---------");
+    }
+
+    inline void Reset() {
+        for (auto& histogram : stats.timers) histogram.Reset();
+        for (auto& counter : stats.counters) counter.store(0, std::memory_order_relaxed);
+    }
+};
+
+#ifdef DFT_PROFILING
+    #define DFT_PROFILE_SCOPE(timer) const Profiling::ScopedTimer dft_profile_scope(Profiling::Timer::timer)
+    #define DFT_PROFILE_COUNT(counter) Profiling::Count(Profiling::Counter::counter)
+    #define DFT_PROFILE_DUMP() Profiling::Dump()
+#else
+    #define DFT_PROFILE_SCOPE(timer) ((void)0)
+    #define DFT_PROFILE_COUNT(counter) ((void)0)
+    #define DFT_PROFILE_DUMP() ((void)0)
+#endif
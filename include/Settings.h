@@ -0,0 +1,85 @@
+#pragma once
+
+#include <SimpleIni.h>
+#include "Utils.h"
+
+namespace Settings {
+
+    const auto ini_path = std::format("Data/SKSE/Plugins/{}.ini", Utilities::mod_name);
+
+    // when to fill the per-base reserve of dynamic forms so gameplay acquisitions come out of the pool
+    enum class PrewarmMode : std::uint32_t {
+        kOff = 0,
+        kDataLoaded = 1,  // once, during kDataLoaded
+        kPostLoad = 2     // after every new game/load, spread across the first frames
+    };
+
+    struct Prewarm {
+        PrewarmMode mode = PrewarmMode::kOff;
+        std::uint32_t reserve = 0;     // pooled forms to keep per base
+        std::uint32_t per_frame = 16;  // forms created per frame in kPostLoad mode
+        std::vector<std::string> bases;  // base editorids
+    };
+
+    Prewarm prewarm;
+
+    bool compress_records = true;  // delta + varint encoding of the cosave form lists
+
+    struct Trace {
+        bool record = false;  // binary trace of the tracker calls, see TraceRecorder.h
+        std::string path = std::format("Data/SKSE/Plugins/{}_trace.bin", Utilities::mod_name);
+    };
+
+    Trace trace;
+
+    struct Log {
+        bool async = false;
+        std::uint32_t queue_size = 8192;     // messages held by the async ring buffer
+        bool overrun_oldest = false;         // when the buffer is full: drop the oldest message instead of blocking
+        std::uint32_t flush_interval_s = 3;  // async mode only flushes on warnings and on this interval
+    };
+
+    Log logging;
+
+    // read before the logger exists, so it must not log itself
+    void LoadLogSettings() {
+        CSimpleIniA ini;
+        ini.SetUnicode();
+        if (ini.LoadFile(ini_path.c_str()) < 0) return;
+
+        logging.async = ini.GetBoolValue("Log", "bAsync", false);
+        logging.queue_size = static_cast<std::uint32_t>(std::max(64L, ini.GetLongValue("Log", "iQueueSize", 8192)));
+        logging.overrun_oldest = ini.GetLongValue("Log", "iOverflowPolicy", 0) == 1;
+        logging.flush_interval_s = static_cast<std::uint32_t>(std::max(1L, ini.GetLongValue("Log", "iFlushIntervalSec", 3)));
+    }
+
+    void LoadSettings() {
+        CSimpleIniA ini;
+        ini.SetUnicode();
+        if (ini.LoadFile(ini_path.c_str()) < 0) {
+            logger::info("No INI found at {}. Using defaults.", ini_path);
+            return;
+        }
+
+        const auto mode = ini.GetLongValue("Prewarm", "iMode", 0);
+        prewarm.mode = mode >= 0 && mode <= 2 ? static_cast<PrewarmMode>(mode) : PrewarmMode::kOff;
+        prewarm.reserve = static_cast<std::uint32_t>(std::max(0L, ini.GetLongValue("Prewarm", "iReservePerBase", 0)));
+        prewarm.per_frame = static_cast<std::uint32_t>(std::max(1L, ini.GetLongValue("Prewarm", "iFormsPerFrame", 16)));
+
+        prewarm.bases.clear();
+        std::stringstream bases(ini.GetValue("Prewarm", "sBaseEditorIDs", ""));
+        for (std::string editorid; std::getline(bases, editorid, ',');) {
+            if (editorid = Utilities::Functions::String::trim(editorid); !editorid.empty()) {
+                prewarm.bases.push_back(editorid);
+            }
+        }
+
+        compress_records = ini.GetBoolValue("Save", "bCompressRecords", true);
+
+        trace.record = ini.GetBoolValue("Trace", "bRecord", false);
+        if (const auto* path = ini.GetValue("Trace", "sPath", nullptr); path && *path) trace.path = path;
+
+        logger::info("Prewarm mode: {}, reserve per base: {}, bases: {}", static_cast<std::uint32_t>(prewarm.mode),
+                     prewarm.reserve, prewarm.bases.size());
+    }
+};
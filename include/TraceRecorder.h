@@ -0,0 +1,209 @@
+#pragma once
+
+#include "Utils.h"
+
+// Opt-in binary trace of the public DynamicFormTracker calls, for profiling real play sessions offline with
+// tools/replay. File layout: u32 magic 'DFTT', u16 version, then records. Every record starts with
+//   u8 op, u8 flags, u8 base form type, u64 start [ns since Start], u32 duration [ns], u32 base formid,
+//   u32 base editorid handle, u32 arg, u32 result, u32 n, followed by n u32 payload words.
+// Editorid handles are defined by a kDefineEditorID record (u8 op, u32 handle, u32 length, chars) before their first
+// use. The base form type is 0 where the call has no base or it was not found.
+class TraceRecorder {
+public:
+    // base is the base formid/editorid where the call has one
+    enum class Op : std::uint8_t {
+        kDefineEditorID = 0,
+        kFetch = 1,            // arg: custom id if kHasCustomID, result: formid
+        kFetchCreate = 2,      // arg: custom id if kHasCustomID, result: formid
+        kFetchCreateMany = 3,  // arg: count, result: forms acquired, payload: custom ids, then the formids acquired
+        kDelete = 4,           // arg: dynamic formid
+        kDeleteMany = 5,       // arg: count, payload: the dynamic formids
+        kDeleteInactives = 6,  // arg: budget [us] or 0 for a full pass, result: deletions pending
+        kEditCustomID = 7,     // base formid: dynamic formid, arg: custom id
+        kSendData = 8,         // result: forms sent
+        kReceiveData = 9,      // result: forms received
+        kReset = 10,
+        kPrewarm = 11,         // arg: reserve, result: forms created, payload: max_create
+        kFetchMany = 12,       // arg: count, result: forms fetched, payload: custom ids, then the formid per slot
+        kEditCustomIDs = 13,   // arg: count, payload: dynamic formid, custom id pairs
+        kRevalidateStale = 14  // arg: budget [us], result: forms still unchecked
+    };
+
+    enum Flags : std::uint8_t {
+        kHasCustomID = 1 << 0,   // arg is a custom id
+        kHasCustomIDs = 1 << 1   // the payload starts with count (has custom id, custom id) pairs
+    };
+
+    static constexpr std::uint32_t kMagic = 0x54544644;  // "DFTT" on disk
+    static constexpr std::uint16_t kVersion = 2;
+
+    static TraceRecorder* GetSingleton() {
+        static TraceRecorder singleton;
+        return &singleton;
+    }
+
+    [[nodiscard]] bool IsEnabled() const { return enabled.load(std::memory_order_relaxed); }
+
+    bool Start(const std::string& path) {
+        std::lock_guard<std::mutex> lock(mutex);
+        file.open(path, std::ios::binary | std::ios::trunc);
+        if (!file) {
+            logger::error("Failed to open trace file {}.", path);
+            return false;
+        }
+        // handles are only defined once per file, so a new file starts over
+        editorids = {};
+        n_defined = 1;
+        buffer.clear();
+        Utilities::Types::PackedWriter writer(buffer);
+        writer.Write(kMagic);
+        writer.Write(kVersion);
+        origin = std::chrono::steady_clock::now();
+        enabled.store(true, std::memory_order_relaxed);
+        logger::info("Recording tracker trace to {}.", path);
+        return true;
+    }
+
+    void Stop() {
+        std::lock_guard<std::mutex> lock(mutex);
+        enabled.store(false, std::memory_order_relaxed);
+        _flush();
+        file.close();
+    }
+
+    // called on save so a crash loses at most the calls since then
+    void Flush() {
+        std::lock_guard<std::mutex> lock(mutex);
+        _flush();
+    }
+
+    // records one call when it goes out of scope. free apart from the IsEnabled check when recording is off.
+    class Scope {
+    public:
+        explicit Scope(const Op a_op, const FormID a_base_formid = 0, const std::string_view a_editorid = {},
+                       const std::uint32_t a_arg = 0)
+            : recorder(GetSingleton()) {
+            if (!recorder->IsEnabled()) {
+                recorder = nullptr;
+                return;
+            }
+            op = a_op;
+            base_formid = a_base_formid;
+            editorid = a_editorid;
+            arg = a_arg;
+            start = std::chrono::steady_clock::now();
+        }
+
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+        ~Scope() {
+            if (recorder) recorder->_record(*this, std::chrono::steady_clock::now());
+        }
+
+        template <typename T>
+        T Return(const T a_result) {
+            result = static_cast<std::uint32_t>(a_result);
+            return a_result;
+        }
+
+        void Result(const std::uint32_t a_result) { result = a_result; }
+
+        void BaseType(const RE::FormType a_type) { base_type = static_cast<std::uint8_t>(a_type); }
+
+        // for kFetch and kFetchCreate
+        void CustomID(const std::optional<std::uint32_t> a_customID) {
+            if (!recorder || !a_customID) return;
+            flags |= kHasCustomID;
+            arg = *a_customID;
+        }
+
+        // for the *Many fetches. nothing is recorded for an empty span.
+        void CustomIDs(const std::span<const std::optional<std::uint32_t>> a_customIDs) {
+            if (!recorder || a_customIDs.empty()) return;
+            flags |= kHasCustomIDs;
+            payload.reserve(payload.size() + 2 * a_customIDs.size());
+            for (const auto& customID : a_customIDs) {
+                payload.push_back(customID.has_value());
+                payload.push_back(customID.value_or(0));
+            }
+        }
+
+        // appends to the payload; copied, so the words need not outlive the scope
+        void Payload(const std::span<const std::uint32_t> a_words) {
+            if (recorder) payload.insert(payload.end(), a_words.begin(), a_words.end());
+        }
+
+        void Payload(const std::uint32_t a_word) {
+            if (recorder) payload.push_back(a_word);
+        }
+
+        [[nodiscard]] bool IsRecording() const { return recorder != nullptr; }
+
+    private:
+        friend class TraceRecorder;
+
+        TraceRecorder* recorder;
+        Op op = Op::kDefineEditorID;
+        std::uint8_t flags = 0;
+        std::uint8_t base_type = 0;
+        FormID base_formid = 0;
+        std::string_view editorid;
+        std::uint32_t arg = 0;
+        std::uint32_t result = 0;
+        std::vector<std::uint32_t> payload;
+        std::chrono::steady_clock::time_point start;
+    };
+
+private:
+    TraceRecorder() = default;
+
+    static constexpr std::size_t kFlushThreshold = 64 * 1024;
+
+    void _record(const Scope& scope, const std::chrono::steady_clock::time_point end) {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (!IsEnabled()) return;
+
+        Utilities::Types::PackedWriter writer(buffer);
+        const auto handle = editorids.Intern(scope.editorid);
+        if (handle >= n_defined) {
+            writer.Write(Op::kDefineEditorID);
+            writer.Write(handle);
+            writer.Write(scope.editorid);
+            n_defined = handle + 1;
+        }
+
+        writer.Write(scope.op);
+        writer.Write(scope.flags);
+        writer.Write(scope.base_type);
+        writer.Write(static_cast<std::uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(scope.start - origin).count()));
+        writer.Write(static_cast<std::uint32_t>(
+            std::min<std::int64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(end - scope.start).count(),
+                                   UINT32_MAX)));
+        writer.Write(scope.base_formid);
+        writer.Write(handle);
+        writer.Write(scope.arg);
+        writer.Write(scope.result);
+        writer.Write(static_cast<std::uint32_t>(scope.payload.size()));
+        for (const auto word : scope.payload) writer.Write(word);
+
+        if (buffer.size() >= kFlushThreshold) _flush();
+    }
+
+    void _flush() {
+        if (!file.is_open() || buffer.empty()) return;
+        file.write(reinterpret_cast<const char*>(buffer.data()), static_cast<std::streamsize>(buffer.size()));
+        file.flush();
+        buffer.clear();
+    }
+
+    std::mutex mutex;
+    std::atomic<bool> enabled = false;
+    std::ofstream file;
+    std::vector<std::uint8_t> buffer;
+    std::chrono::steady_clock::time_point origin;
+
+    Utilities::Types::EditorIDTable editorids;
+    Utilities::Types::EditorIDHandle n_defined = 1;  // handle 0 is the empty string and needs no definition
+};
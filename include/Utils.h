@@ -3,6 +3,22 @@
 #include <windows.h>
 #include <ClibUtil/editorID.hpp>
 
+// Per-record trace logging goes through DFT_TRACE, which is compiled out above DFT_LOG_LEVEL (a SPDLOG_LEVEL_* value)
+// so its arguments are not even evaluated. Defaults to trace in debug and info in release builds.
+#ifndef DFT_LOG_LEVEL
+    #ifdef NDEBUG
+        #define DFT_LOG_LEVEL SPDLOG_LEVEL_INFO
+    #else
+        #define DFT_LOG_LEVEL SPDLOG_LEVEL_TRACE
+    #endif
+#endif
+
+#if DFT_LOG_LEVEL <= SPDLOG_LEVEL_TRACE
+    #define DFT_TRACE(...) logger::trace(__VA_ARGS__)
+#else
+    #define DFT_TRACE(...) ((void)0)
+#endif
+
 namespace Utilities {
 
     const auto mod_name = static_cast<std::string>(SKSE::PluginDeclaration::GetSingleton()->GetName());
@@ -497,35 +513,206 @@ namespace Utilities {
 
     namespace Types {
 
+        using EditorIDHandle = std::uint32_t;
+
+        // base formid + interned editorid. trivially copyable so it is cheap to use as a key everywhere
+        struct BaseKey {
+            FormID formid = 0;
+            EditorIDHandle editorid = 0;
+
+            auto operator<=>(const BaseKey&) const = default;
+        };
+
+        struct BaseKeyHash {
+            std::size_t operator()(const BaseKey& a_key) const noexcept {
+                // splitmix64 finalizer over the packed key, no string hashing involved
+                auto x = (static_cast<std::uint64_t>(a_key.formid) << 32) | a_key.editorid;
+                x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+                x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+                return static_cast<std::size_t>(x ^ (x >> 31));
+            }
+        };
+
+        // hands out stable 32-bit handles for editorids. handle 0 is the empty string.
+        class EditorIDTable {
+            struct StringHash {
+                using is_transparent = void;
+                std::size_t operator()(std::string_view a_str) const noexcept {
+                    return std::hash<std::string_view>{}(a_str);
+                }
+            };
+
+            std::vector<std::string> strings{""};
+            std::unordered_map<std::string, EditorIDHandle, StringHash, std::equal_to<>> handles{{"", 0}};
+
+        public:
+            EditorIDHandle Intern(const std::string_view a_editorid) {
+                if (const auto it = handles.find(a_editorid); it != handles.end()) return it->second;
+                const auto handle = static_cast<EditorIDHandle>(strings.size());
+                strings.emplace_back(a_editorid);
+                handles.emplace(strings.back(), handle);
+                return handle;
+            }
+
+            // does not intern; nullopt if the editorid was never seen
+            [[nodiscard]] std::optional<EditorIDHandle> Find(const std::string_view a_editorid) const {
+                if (const auto it = handles.find(a_editorid); it != handles.end()) return it->second;
+                return std::nullopt;
+            }
+
+            [[nodiscard]] const std::string& Get(const EditorIDHandle a_handle) const {
+                return a_handle < strings.size() ? strings[a_handle] : strings.front();
+            }
+        };
+
         struct DFSaveData {
             FormID dyn_formid = 0;
             std::pair<bool, uint32_t> custom_id = {false, 0};
             float acteff_elapsed = -1.f;
         };
-        using DFSaveDataLHS = std::pair<FormID, std::string>;
+        // v1 wrote DFSaveData as it sits in memory. Decoded field by field for the same reason as the string pairs.
+        constexpr std::size_t kDFV1EntrySize = sizeof(DFSaveData);
+        static_assert(kDFV1EntrySize == 16);
+
+        inline DFSaveData DecodeV1Entry(const std::array<std::uint8_t, kDFV1EntrySize>& raw) {
+            DFSaveData entry;
+            std::memcpy(&entry.dyn_formid, raw.data(), sizeof(FormID));
+            entry.custom_id.first = raw[4] != 0;
+            std::memcpy(&entry.custom_id.second, raw.data() + 8, sizeof(std::uint32_t));
+            std::memcpy(&entry.acteff_elapsed, raw.data() + 12, sizeof(float));
+            return entry;
+        }
+
+        using DFSaveDataLHS = BaseKey;
         using DFSaveDataRHS = std::vector<DFSaveData>;
 
+        // cosave record versions. v1 writes every field with its own call, v2 writes one packed block per base.
+        constexpr std::uint32_t kDFSaveVersion1 = 1;
+        constexpr std::uint32_t kDFSaveVersion2 = 2;
+        constexpr std::uint32_t kDFSaveVersion = kDFSaveVersion2;
+
+        // how the entries of a v2 base block are encoded.
+        // kDeltaVarint needs entries sorted by dyn_formid: varint formid deltas, a has_custom_id bitmap followed by
+        // varint custom ids of the flagged entries, then an active effect bitmap followed by f32 elapsed times.
+        enum class DFBlockEncoding : std::uint8_t { kRaw = 0, kDeltaVarint = 1 };
+
+        // v2 raw entry: u32 dyn_formid, u32 custom_id, f32 acteff_elapsed, u8 has_custom_id. no padding.
+        constexpr std::size_t kDFPackedEntrySize = 13;
+
+        // appends fixed-width little-endian fields to a byte buffer
+        class PackedWriter {
+            std::vector<std::uint8_t>& buffer;
+
+        public:
+            explicit PackedWriter(std::vector<std::uint8_t>& a_buffer) : buffer(a_buffer) {}
+
+            template <typename T>
+                requires std::is_trivially_copyable_v<T>
+            void Write(const T& a_value) {
+                const auto* bytes = reinterpret_cast<const std::uint8_t*>(&a_value);
+                buffer.insert(buffer.end(), bytes, bytes + sizeof(T));
+            }
+
+            void Write(const std::string_view a_str) {
+                Write(static_cast<std::uint32_t>(a_str.size()));
+                buffer.insert(buffer.end(), a_str.begin(), a_str.end());
+            }
+
+            // LEB128, 1 to 5 bytes
+            void WriteVarint(std::uint32_t a_value) {
+                while (a_value >= 0x80) {
+                    buffer.push_back(static_cast<std::uint8_t>(a_value | 0x80));
+                    a_value >>= 7;
+                }
+                buffer.push_back(static_cast<std::uint8_t>(a_value));
+            }
+
+            void WriteBitmap(const std::vector<bool>& a_bits) {
+                const auto offset = buffer.size();
+                buffer.resize(offset + (a_bits.size() + 7) / 8, 0);
+                for (std::size_t i = 0; i < a_bits.size(); i++) {
+                    if (a_bits[i]) buffer[offset + i / 8] |= static_cast<std::uint8_t>(1u << (i % 8));
+                }
+            }
+        };
+
+        // bounds-checked counterpart of PackedWriter. every Read fails instead of running past the block.
+        class PackedReader {
+            std::span<const std::uint8_t> data;
+            std::size_t pos = 0;
+
+        public:
+            explicit PackedReader(const std::span<const std::uint8_t> a_data) : data(a_data) {}
+
+            [[nodiscard]] std::size_t Remaining() const { return data.size() - pos; }
+
+            template <typename T>
+                requires std::is_trivially_copyable_v<T>
+            bool Read(T& a_value) {
+                if (Remaining() < sizeof(T)) return false;
+                std::memcpy(&a_value, data.data() + pos, sizeof(T));
+                pos += sizeof(T);
+                return true;
+            }
+
+            bool Read(std::string& a_str) {
+                std::uint32_t size = 0;
+                if (!Read(size) || Remaining() < size) return false;
+                a_str.assign(reinterpret_cast<const char*>(data.data() + pos), size);
+                pos += size;
+                return true;
+            }
+
+            bool ReadVarint(std::uint32_t& a_value) {
+                a_value = 0;
+                for (std::uint32_t shift = 0; shift < 35; shift += 7) {
+                    std::uint8_t byte = 0;
+                    if (!Read(byte)) return false;
+                    a_value |= static_cast<std::uint32_t>(byte & 0x7F) << shift;
+                    if (!(byte & 0x80)) return true;
+                }
+                return false;
+            }
+
+            bool ReadBitmap(std::vector<bool>& a_bits, const std::size_t a_size) {
+                if (Remaining() < (a_size + 7) / 8) return false;
+                a_bits.assign(a_size, false);
+                for (std::size_t i = 0; i < a_size; i++) {
+                    a_bits[i] = (data[pos + i / 8] >> (i % 8)) & 1;
+                }
+                pos += (a_size + 7) / 8;
+                return true;
+            }
+        };
+
     };
 
 
-    bool read_string(SKSE::SerializationInterface* a_intfc, std::string& a_str) {
+    // templated on the interface so the string codec only needs ReadRecordData/WriteRecordData
+    template <class Intfc = SKSE::SerializationInterface>
+    bool read_string(Intfc* a_intfc, std::string& a_str) {
         std::vector<std::pair<int, bool>> encodedStr;
         std::size_t size;
         if (!a_intfc->ReadRecordData(size)) {
             return false;
         }
         for (std::size_t i = 0; i < size; i++) {
-            std::pair<int, bool> temp_pair;
-            if (!a_intfc->ReadRecordData(temp_pair)) {
+            // the pair is read as bytes so a corrupt cosave can't produce a bool that is neither true nor false
+            std::array<std::uint8_t, sizeof(std::pair<int, bool>)> raw{};
+            if (a_intfc->ReadRecordData(raw.data(), static_cast<std::uint32_t>(raw.size())) != raw.size()) {
                 return false;
             }
+            std::pair<int, bool> temp_pair;
+            std::memcpy(&temp_pair.first, raw.data(), sizeof(int));
+            temp_pair.second = raw[sizeof(int)] != 0;
             encodedStr.push_back(temp_pair);
         }
         a_str = Functions::String::decodeString(encodedStr);
         return true;
     }
 
-    bool write_string(SKSE::SerializationInterface* a_intfc, const std::string& a_str) {
+    template <class Intfc = SKSE::SerializationInterface>
+    bool write_string(Intfc* a_intfc, const std::string& a_str) {
         const auto encodedStr = Functions::String::encodeString(a_str);
         // i first need the size to know no of iterations
         const auto size = encodedStr.size();
@@ -560,9 +747,9 @@ namespace Utilities {
 
         virtual const char* GetType() = 0;
 
+        // both take the record version, so a record is always read and written in the layout it was opened with
         virtual bool Save(SKSE::SerializationInterface*, std::uint32_t, std::uint32_t) { return false; };
-        virtual bool Save(SKSE::SerializationInterface*) { return false; };
-        virtual bool Load(SKSE::SerializationInterface*) { return false; };
+        virtual bool Load(SKSE::SerializationInterface*, std::uint32_t) { return false; };
 
         void Clear() {
             Locker locker(m_Lock);
@@ -580,12 +767,246 @@ namespace Utilities {
     };
 
     class DFSaveLoadData : public BaseData<Types::DFSaveDataLHS, Types::DFSaveDataRHS> {
+    protected:
+        // editorids only exist as strings here and at the papyrus boundary
+        Types::EditorIDTable m_EditorIDs;
+        bool m_CompressRecords = true;
+
     public:
         void DumpToLog() override {
             // nothing for now
         }
 
-        [[nodiscard]] bool Save(SKSE::SerializationInterface* serializationInterface) override {
+        // v2 records use the delta + varint encoding for sorted entry lists when enabled
+        void SetCompression(const bool a_compress) {
+            if (m_CompressRecords == a_compress) return;
+            m_CompressRecords = a_compress;
+            OnCompressionChanged();
+        }
+
+        [[nodiscard]] bool Save(SKSE::SerializationInterface* serializationInterface, std::uint32_t type,
+                                std::uint32_t version) override {
+            if (!serializationInterface->OpenRecord(type, version)) {
+                logger::error("Failed to open record for Data Serialization!");
+                return false;
+            }
+
+            return version < Types::kDFSaveVersion2 ? SaveV1(serializationInterface) : SaveV2(serializationInterface);
+        }
+
+        // version is the one reported by GetNextRecordInfo, so records written by older versions keep loading
+        [[nodiscard]] bool Load(SKSE::SerializationInterface* serializationInterface, std::uint32_t version) override {
+            return version < Types::kDFSaveVersion2 ? LoadV1(serializationInterface) : LoadV2(serializationInterface);
+        }
+
+    protected:
+        // for subclasses that cache encoded records
+        virtual void OnCompressionChanged() {}
+
+        [[nodiscard]] virtual bool SaveV2(SKSE::SerializationInterface* serializationInterface) {
+            assert(serializationInterface);
+            Locker locker(m_Lock);
+
+            const auto numRecords = static_cast<std::uint32_t>(m_Data.size());
+            if (!serializationInterface->WriteRecordData(numRecords)) {
+                logger::error("Failed to save {} data records", numRecords);
+                return false;
+            }
+
+            // each base goes out as its byte size followed by one contiguous block
+            std::vector<std::uint8_t> block;
+            std::size_t rawSize = sizeof(numRecords);
+            std::size_t writtenSize = sizeof(numRecords);
+            for (const auto& [lhs, rhs] : m_Data) {
+                const auto editorid = std::string_view(m_EditorIDs.Get(lhs.editorid));
+                EncodeBlock(block, lhs.formid, editorid, rhs, m_CompressRecords);
+                if (!WriteBlock(serializationInterface, block)) return false;
+                rawSize += RawBlockSize(editorid.size(), rhs.size());
+                writtenSize += sizeof(std::uint32_t) + block.size();
+            }
+            logger::info("Saved {} data records: {} bytes written, {} bytes raw.", numRecords, writtenSize, rawSize);
+            return true;
+        }
+
+        // one v2 block: formid, editorid, encoding, count, entries
+        static void EncodeBlock(std::vector<std::uint8_t>& block, const FormID formid, const std::string_view editorid,
+                                const std::span<const Types::DFSaveData> rhs, const bool compress) {
+            block.clear();
+            block.reserve(32 + editorid.size() + rhs.size() * Types::kDFPackedEntrySize);
+            Types::PackedWriter writer(block);
+            writer.Write(formid);
+            writer.Write(editorid);
+            const auto encoding = compress && std::ranges::is_sorted(rhs, {}, &Types::DFSaveData::dyn_formid)
+                                      ? Types::DFBlockEncoding::kDeltaVarint
+                                      : Types::DFBlockEncoding::kRaw;
+            writer.Write(encoding);
+            writer.Write(static_cast<std::uint32_t>(rhs.size()));
+            EncodeEntries(writer, rhs, encoding);
+        }
+
+        [[nodiscard]] static bool WriteBlock(SKSE::SerializationInterface* serializationInterface,
+                                             const std::vector<std::uint8_t>& block) {
+            const auto blockSize = static_cast<std::uint32_t>(block.size());
+            if (!serializationInterface->WriteRecordData(blockSize) ||
+                !serializationInterface->WriteRecordData(block.data(), blockSize)) {
+                logger::error("Failed to save data block of size {}", blockSize);
+                return false;
+            }
+            return true;
+        }
+
+        // grows the block chunk by chunk, so a corrupt size can't allocate much more than the record holds
+        [[nodiscard]] static bool ReadBlock(SKSE::SerializationInterface* serializationInterface,
+                                            std::vector<std::uint8_t>& block, const std::uint32_t blockSize) {
+            constexpr std::uint32_t kChunkSize = 1 << 16;
+            block.clear();
+            while (block.size() < blockSize) {
+                const auto pos = block.size();
+                const auto n = std::min(kChunkSize, static_cast<std::uint32_t>(blockSize - pos));
+                block.resize(pos + n);
+                if (serializationInterface->ReadRecordData(block.data() + pos, n) != n) return false;
+            }
+            return true;
+        }
+
+        // size the block would take with kRaw entries, incl. its size prefix
+        static constexpr std::size_t RawBlockSize(const std::size_t editorid_size, const std::size_t n_entries) {
+            return sizeof(std::uint32_t) + sizeof(FormID) + sizeof(std::uint32_t) + editorid_size + 1 +
+                   sizeof(std::uint32_t) + n_entries * Types::kDFPackedEntrySize;
+        }
+
+        // inverse of EncodeBlock. Works on the bytes alone, so corrupted input can be fed to it without a cosave.
+        [[nodiscard]] static bool DecodeBlock(const std::span<const std::uint8_t> block, FormID& formid,
+                                              std::string& editorid, Types::DFSaveDataRHS& rhs) {
+            Types::PackedReader reader(block);
+            auto encoding = Types::DFBlockEncoding::kRaw;
+            std::uint32_t rhsSize = 0;
+            if (!reader.Read(formid) || !reader.Read(editorid) || !reader.Read(encoding) || !reader.Read(rhsSize)) {
+                logger::error("Malformed data block header");
+                return false;
+            }
+            if (!DecodeEntries(reader, rhsSize, encoding, rhs)) {
+                logger::error("Malformed data block for editorid {} with encoding {}", editorid,
+                              static_cast<std::uint32_t>(encoding));
+                return false;
+            }
+            return true;
+        }
+
+        static void EncodeEntries(Types::PackedWriter& writer, const std::span<const Types::DFSaveData> rhs,
+                                  const Types::DFBlockEncoding encoding) {
+            if (encoding == Types::DFBlockEncoding::kRaw) {
+                for (const auto& rhs_ : rhs) {
+                    writer.Write(rhs_.dyn_formid);
+                    writer.Write(rhs_.custom_id.second);
+                    writer.Write(rhs_.acteff_elapsed);
+                    writer.Write(static_cast<std::uint8_t>(rhs_.custom_id.first));
+                }
+                return;
+            }
+
+            std::vector<bool> flags(rhs.size());
+            FormID prev = 0;
+            for (const auto& rhs_ : rhs) {
+                writer.WriteVarint(rhs_.dyn_formid - prev);
+                prev = rhs_.dyn_formid;
+            }
+            for (std::size_t i = 0; i < rhs.size(); i++) flags[i] = rhs[i].custom_id.first;
+            writer.WriteBitmap(flags);
+            for (const auto& rhs_ : rhs) {
+                if (rhs_.custom_id.first) writer.WriteVarint(rhs_.custom_id.second);
+            }
+            for (std::size_t i = 0; i < rhs.size(); i++) flags[i] = rhs[i].acteff_elapsed >= 0.f;
+            writer.WriteBitmap(flags);
+            for (const auto& rhs_ : rhs) {
+                if (rhs_.acteff_elapsed >= 0.f) writer.Write(rhs_.acteff_elapsed);
+            }
+        }
+
+        // false if the entries do not exactly fill the rest of the block
+        static bool DecodeEntries(Types::PackedReader& reader, const std::uint32_t rhsSize,
+                                  const Types::DFBlockEncoding encoding, Types::DFSaveDataRHS& rhs) {
+            if (encoding == Types::DFBlockEncoding::kRaw) {
+                if (reader.Remaining() != static_cast<std::size_t>(rhsSize) * Types::kDFPackedEntrySize) return false;
+                rhs.resize(rhsSize);
+                for (auto& rhs_ : rhs) {
+                    std::uint8_t has_customid = 0;
+                    reader.Read(rhs_.dyn_formid);
+                    reader.Read(rhs_.custom_id.second);
+                    reader.Read(rhs_.acteff_elapsed);
+                    reader.Read(has_customid);
+                    rhs_.custom_id.first = has_customid != 0;
+                }
+                return true;
+            }
+            if (encoding != Types::DFBlockEncoding::kDeltaVarint) return false;
+
+            // every entry takes at least one byte, which bounds the allocation for corrupt counts
+            if (reader.Remaining() < rhsSize) return false;
+            rhs.assign(rhsSize, {});
+            FormID prev = 0;
+            for (auto& rhs_ : rhs) {
+                std::uint32_t delta = 0;
+                if (!reader.ReadVarint(delta)) return false;
+                rhs_.dyn_formid = prev + delta;
+                prev = rhs_.dyn_formid;
+            }
+            std::vector<bool> flags;
+            if (!reader.ReadBitmap(flags, rhsSize)) return false;
+            for (std::size_t i = 0; i < rhs.size(); i++) {
+                rhs[i].custom_id.first = flags[i];
+                if (flags[i] && !reader.ReadVarint(rhs[i].custom_id.second)) return false;
+            }
+            if (!reader.ReadBitmap(flags, rhsSize)) return false;
+            for (std::size_t i = 0; i < rhs.size(); i++) {
+                if (flags[i] && !reader.Read(rhs[i].acteff_elapsed)) return false;
+            }
+            return reader.Remaining() == 0;
+        }
+
+        [[nodiscard]] bool LoadV2(SKSE::SerializationInterface* serializationInterface) {
+            assert(serializationInterface);
+
+            std::uint32_t numRecords = 0;
+            if (!serializationInterface->ReadRecordData(numRecords)) {
+                logger::error("Failed to read the number of data records");
+                return false;
+            }
+            logger::info("Loading data from serialization interface with size: {}", numRecords);
+
+            Locker locker(m_Lock);
+            m_Data.clear();
+
+            std::vector<std::uint8_t> block;
+            for (std::uint32_t i = 0; i < numRecords; i++) {
+                std::uint32_t blockSize = 0;
+                if (!serializationInterface->ReadRecordData(blockSize)) {
+                    logger::error("Failed to read data block size");
+                    return false;
+                }
+                if (!ReadBlock(serializationInterface, block, blockSize)) {
+                    logger::error("Failed to read data block of size {}", blockSize);
+                    return false;
+                }
+
+                // the whole block is consumed already, so a bad block can be skipped without losing the stream
+                FormID formid = 0;
+                std::string editorid;
+                Types::DFSaveDataRHS rhs;
+                if (!DecodeBlock(block, formid, editorid, rhs)) continue;
+                if (!serializationInterface->ResolveFormID(formid, formid)) {
+                    logger::error("Failed to resolve form ID, 0x{:X}.", formid);
+                    continue;
+                }
+
+                m_Data[{formid, m_EditorIDs.Intern(editorid)}] = std::move(rhs);
+                logger::info("Loaded data for formid {}, editorid {}", formid, editorid);
+            }
+
+            return true;
+        }
+
+        [[nodiscard]] virtual bool SaveV1(SKSE::SerializationInterface* serializationInterface) {
             assert(serializationInterface);
             Locker locker(m_Lock);
 
@@ -597,15 +1018,15 @@ namespace Utilities {
 
             for (const auto& [lhs, rhs] : m_Data) {
                 // we serialize formid, editorid, and refid separately
-                std::uint32_t formid = lhs.first;
-                logger::trace("Formid:{}", formid);
+                std::uint32_t formid = lhs.formid;
+                DFT_TRACE("Formid:{}", formid);
                 if (!serializationInterface->WriteRecordData(formid)) {
                     logger::error("Failed to save formid");
                     return false;
                 }
 
-                const std::string editorid = lhs.second;
-                logger::trace("Editorid:{}", editorid);
+                const auto& editorid = m_EditorIDs.Get(lhs.editorid);
+                DFT_TRACE("Editorid:{}", editorid);
                 write_string(serializationInterface, editorid);
 
                 // save the number of rhs records
@@ -616,7 +1037,7 @@ namespace Utilities {
                 }
 
                 for (const auto& rhs_ : rhs) {
-                    logger::trace("size of rhs_: {}", sizeof(rhs_));
+                    DFT_TRACE("size of rhs_: {}", sizeof(rhs_));
                     if (!serializationInterface->WriteRecordData(rhs_)) {
                         logger::error("Failed to save data");
                         return false;
@@ -626,64 +1047,54 @@ namespace Utilities {
             return true;
         }
 
-        [[nodiscard]] bool Save(SKSE::SerializationInterface* serializationInterface, std::uint32_t type,
-                                std::uint32_t version) override {
-            if (!serializationInterface->OpenRecord(type, version)) {
-                logger::error("Failed to open record for Data Serialization!");
-                return false;
-            }
-
-            return Save(serializationInterface);
-        }
-
-        [[nodiscard]] bool Load(SKSE::SerializationInterface* serializationInterface) override {
+        [[nodiscard]] bool LoadV1(SKSE::SerializationInterface* serializationInterface) {
             assert(serializationInterface);
 
-            std::size_t recordDataSize;
-            serializationInterface->ReadRecordData(recordDataSize);
+            std::size_t recordDataSize = 0;
+            if (!serializationInterface->ReadRecordData(recordDataSize)) {
+                logger::error("Failed to read the number of data records");
+                return false;
+            }
             logger::info("Loading data from serialization interface with size: {}", recordDataSize);
 
             Locker locker(m_Lock);
             m_Data.clear();
 
-            logger::trace("Loading data from serialization interface.");
-            for (auto i = 0; i < recordDataSize; i++) {
-                Types::DFSaveDataRHS rhs;
-
+            DFT_TRACE("Loading data from serialization interface.");
+            for (std::size_t i = 0; i < recordDataSize; i++) {
+                // v1 records have no size prefix, so every field is read before a record can be dropped
                 std::uint32_t formid = 0;
-                logger::trace("ReadRecordData:{}", serializationInterface->ReadRecordData(formid));
-                if (!serializationInterface->ResolveFormID(formid, formid)) {
-                    logger::error("Failed to resolve form ID, 0x{:X}.", formid);
-                    continue;
-                }
-
                 std::string editorid;
-                if (!read_string(serializationInterface, editorid)) {
-                    logger::error("Failed to read editorid");
+                std::size_t rhsSize = 0;
+                if (!serializationInterface->ReadRecordData(formid) ||
+                    !read_string(serializationInterface, editorid) ||
+                    !serializationInterface->ReadRecordData(rhsSize)) {
+                    logger::error("Truncated data record {} of {}", i, recordDataSize);
                     return false;
                 }
 
-                logger::trace("Formid:{}", formid);
-                logger::trace("Editorid:{}", editorid);
-
-                Types::DFSaveDataLHS lhs({formid, editorid});
-                logger::trace("Reading value...");
-
-                std::size_t rhsSize = 0;
-                logger::trace("ReadRecordData: {}", serializationInterface->ReadRecordData(rhsSize));
-                logger::trace("rhsSize: {}", rhsSize);
-
-                for (auto j = 0; j < rhsSize; j++) {
-                    Types::DFSaveData rhs_;
-                    logger::trace("ReadRecordData: {}", serializationInterface->ReadRecordData(rhs_));
-                    logger::trace(
+                Types::DFSaveDataRHS rhs;
+                for (std::size_t j = 0; j < rhsSize; j++) {
+                    std::array<std::uint8_t, Types::kDFV1EntrySize> raw{};
+                    if (serializationInterface->ReadRecordData(raw.data(), static_cast<std::uint32_t>(raw.size())) !=
+                        raw.size()) {
+                        logger::error("Truncated data for editorid {}", editorid);
+                        return false;
+                    }
+                    const auto rhs_ = Types::DecodeV1Entry(raw);
+                    DFT_TRACE(
                         "rhs_ content: dyn_formid: {}, customid_bool: {},"
                         "customid: {}, acteff_elapsed: {}",
                         rhs_.dyn_formid, rhs_.custom_id.first, rhs_.custom_id.second, rhs_.acteff_elapsed);
                     rhs.push_back(rhs_);
                 }
 
-                m_Data[lhs] = rhs;
+                if (!serializationInterface->ResolveFormID(formid, formid)) {
+                    logger::error("Failed to resolve form ID, 0x{:X}.", formid);
+                    continue;
+                }
+
+                m_Data[{formid, m_EditorIDs.Intern(editorid)}] = std::move(rhs);
                 logger::info("Loaded data for formid {}, editorid {}", formid, editorid);
             }
 
@@ -1,4 +1,27 @@
 #include "DynamicFormTracker.h"
+#include "Papyrus.h"
+#include "Settings.h"
+
+// fills the reserve of every configured base. max_per_call bounds the work so it can be spread across frames.
+// returns true once every base is topped up.
+bool PrewarmPools(const size_t max_per_call = SIZE_MAX) {
+    size_t budget = max_per_call;
+    for (const auto& editorid : Settings::prewarm.bases) {
+        const auto n_created = DFT->Prewarm(editorid, Settings::prewarm.reserve, budget);
+        budget -= n_created;
+        if (!budget) return false;
+    }
+    return true;
+}
+
+void PrewarmOverFrames(const std::chrono::steady_clock::time_point start) {
+    if (!PrewarmPools(Settings::prewarm.per_frame)) {
+        SKSE::GetTaskInterface()->AddTask([start]() { PrewarmOverFrames(start); });
+        return;
+    }
+    const auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start);
+    logger::info("Prewarming dynamic form pools took {} ms.", elapsed.count());
+}
 
 void OnMessage(SKSE::MessagingInterface::Message* message) {
     if (message->type == SKSE::MessagingInterface::kDataLoaded) {
@@ -8,10 +31,23 @@ void OnMessage(SKSE::MessagingInterface::Message* message) {
             return;
         }
         DFT = DynamicFormTracker::GetSingleton();
+        Settings::LoadSettings();
+        DFT->SetCompression(Settings::compress_records);
+        if (Settings::trace.record) TraceRecorder::GetSingleton()->Start(Settings::trace.path);
+        if (Settings::prewarm.mode == Settings::PrewarmMode::kDataLoaded) {
+            const auto start = std::chrono::steady_clock::now();
+            PrewarmPools();
+            const auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start);
+            logger::info("Prewarming dynamic form pools took {} ms.", elapsed.count());
+        }
         // Start
     }
     if (message->type == SKSE::MessagingInterface::kNewGame || message->type == SKSE::MessagingInterface::kPostLoadGame) {
         // Post-load
+        if (DFT) DFT->RevalidateOverFrames(std::chrono::microseconds(1000));
+        if (DFT && Settings::prewarm.mode == Settings::PrewarmMode::kPostLoad) {
+            PrewarmOverFrames(std::chrono::steady_clock::now());
+        }
     }
 }
 
@@ -21,17 +57,30 @@ static void SetupLog() {
     auto pluginName = SKSE::PluginDeclaration::GetSingleton()->GetName();
     auto logFilePath = *logsFolder / std::format("{}.log", pluginName);
     auto fileLoggerPtr = std::make_shared<spdlog::sinks::basic_file_sink_mt>(logFilePath.string(), true);
-    auto loggerPtr = std::make_shared<spdlog::logger>("log", std::move(fileLoggerPtr));
+    Settings::LoadLogSettings();
+    std::shared_ptr<spdlog::logger> loggerPtr;
+    if (Settings::logging.async) {
+        // one background thread formats and writes; callers only enqueue
+        spdlog::init_thread_pool(Settings::logging.queue_size, 1);
+        loggerPtr = std::make_shared<spdlog::async_logger>(
+            "log", std::move(fileLoggerPtr), spdlog::thread_pool(),
+            Settings::logging.overrun_oldest ? spdlog::async_overflow_policy::overrun_oldest
+                                         : spdlog::async_overflow_policy::block);
+    } else loggerPtr = std::make_shared<spdlog::logger>("log", std::move(fileLoggerPtr));
     spdlog::set_default_logger(std::move(loggerPtr));
 #ifndef NDEBUG
     spdlog::set_level(spdlog::level::trace);
-    spdlog::flush_on(spdlog::level::trace);
+    spdlog::flush_on(Settings::logging.async ? spdlog::level::warn : spdlog::level::trace);
 #else
     spdlog::set_level(spdlog::level::info);
-    spdlog::flush_on(spdlog::level::info);
+    spdlog::flush_on(Settings::logging.async ? spdlog::level::warn : spdlog::level::info);
 #endif
+    if (Settings::logging.async) spdlog::flush_every(std::chrono::seconds(Settings::logging.flush_interval_s));
     logger::info("Name of the plugin is {}.", pluginName);
     logger::info("Version of the plugin is {}.", SKSE::PluginDeclaration::GetSingleton()->GetVersion());
+    if (Settings::logging.async) {
+        logger::info("Async logging with a queue of {} messages.", Settings::logging.queue_size);
+    }
 }
 
 SKSEPluginLoad(const SKSE::LoadInterface *skse) {
@@ -39,5 +88,7 @@ SKSEPluginLoad(const SKSE::LoadInterface *skse) {
     SetupLog();
     logger::info("Plugin loaded");
     SKSE::Init(skse);
+    SKSE::GetMessagingInterface()->RegisterListener(OnMessage);
+    SKSE::GetPapyrusInterface()->Register(Papyrus::Register);
     return true;
 }
\ No newline at end of file
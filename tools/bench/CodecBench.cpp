@@ -0,0 +1,121 @@
+#include "Host/Bench.h"
+#include "Utils.h"
+
+// Save and Load of the cosave record at 1k to 1M tracked forms, in the v1 layout and in v2 with raw and with
+// delta + varint entries. Runs against the in-memory SerializationInterface, so what is measured is the codec and the
+// per-call overhead, which the interface counts. Every round trip is checked against the data it started from.
+//
+//   dft_codec_bench [forms per base] [repetitions]
+
+namespace {
+
+    class CodecBench : public Utilities::DFSaveLoadData {
+    public:
+        const char* GetType() override { return "CodecBench"; }
+
+        // one base per forms_per_base forms; a quarter of the forms carry a custom id, an eighth an active effect
+        void Fill(const std::size_t a_nForms, const std::size_t a_formsPerBase) {
+            m_Data.clear();
+            FormID next = 0xFF000800;
+            for (std::size_t base = 0, n = 0; n < a_nForms; ++base) {
+                const Utilities::Types::BaseKey key{static_cast<FormID>(0x00010000 + base),
+                                                    m_EditorIDs.Intern(std::format("DFTBenchBase{}", base))};
+                auto& rhs = m_Data[key];
+                for (std::size_t i = 0; i < a_formsPerBase && n < a_nForms; ++i, ++n) {
+                    const bool has_customid = i % 4 == 0;
+                    rhs.push_back({next++, {has_customid, has_customid ? static_cast<std::uint32_t>(i) : 0},
+                                   i % 8 == 0 ? 1.5f : -1.f});
+                }
+            }
+        }
+
+        [[nodiscard]] bool SameAs(const CodecBench& a_other) const {
+            if (m_Data.size() != a_other.m_Data.size()) return false;
+            for (auto it = m_Data.begin(), jt = a_other.m_Data.begin(); it != m_Data.end(); ++it, ++jt) {
+                if (it->first.formid != jt->first.formid ||
+                    m_EditorIDs.Get(it->first.editorid) != a_other.m_EditorIDs.Get(jt->first.editorid) ||
+                    it->second.size() != jt->second.size()) {
+                    return false;
+                }
+                for (std::size_t i = 0; i < it->second.size(); ++i) {
+                    const auto& lhs = it->second[i];
+                    const auto& rhs = jt->second[i];
+                    if (lhs.dyn_formid != rhs.dyn_formid || lhs.custom_id != rhs.custom_id ||
+                        lhs.acteff_elapsed != rhs.acteff_elapsed) {
+                        return false;
+                    }
+                }
+            }
+            return true;
+        }
+    };
+
+    struct Layout {
+        std::string_view name;
+        std::uint32_t version;
+        bool compress;
+    };
+
+    constexpr std::uint32_t kRecordType = 0x44465442;  // DFTB
+
+    constexpr std::array kLayouts{Layout{"v1", Utilities::Types::kDFSaveVersion1, false},
+                                  Layout{"v2 raw", Utilities::Types::kDFSaveVersion2, false},
+                                  Layout{"v2 delta+varint", Utilities::Types::kDFSaveVersion2, true}};
+};
+
+int main(const int argc, char** argv) {
+    spdlog::set_level(spdlog::level::warn);
+
+    const std::size_t forms_per_base = argc > 1 ? std::stoul(argv[1]) : 100;
+    const std::size_t repetitions = argc > 2 ? std::stoul(argv[2]) : 5;
+
+    Host::Bench::PrintHeader();
+    bool ok = true;
+    for (const std::size_t n_forms : {1'000uz, 10'000uz, 100'000uz, 1'000'000uz}) {
+        CodecBench data;
+        data.Fill(n_forms, forms_per_base);
+        for (const auto& layout : kLayouts) {
+            data.SetCompression(layout.compress);
+
+            std::size_t n_bytes = 0;
+            std::size_t n_save_calls = 0;
+            std::size_t n_load_calls = 0;
+            SKSE::SerializationInterface intfc;
+            const auto save = Host::Bench::Run(
+                std::format("save {} {}", n_forms, layout.name), repetitions,
+                [&](std::size_t) {
+                    if (!data.Save(&intfc, kRecordType, layout.version)) ok = false;
+                },
+                [&](std::size_t) {
+                    intfc = {};
+                });
+            n_bytes = intfc.Bytes().size();
+            n_save_calls = intfc.GetNCalls();
+
+            CodecBench loaded;
+            const auto load = Host::Bench::Run(
+                std::format("load {} {}", n_forms, layout.name), repetitions,
+                [&](std::size_t) {
+                    std::uint32_t type = 0;
+                    std::uint32_t version = 0;
+                    std::uint32_t length = 0;
+                    if (!intfc.GetNextRecordInfo(type, version, length) || !loaded.Load(&intfc, version)) ok = false;
+                },
+                [&](std::size_t) {
+                    intfc.Rewind();
+                    intfc.ResetNCalls();
+                });
+            n_load_calls = intfc.GetNCalls();
+
+            if (!loaded.SameAs(data)) {
+                std::cerr << std::format("round trip mismatch: {} forms, {}\n", n_forms, layout.name);
+                ok = false;
+            }
+            Host::Bench::Print(save);
+            Host::Bench::Print(load);
+            std::cout << std::format("  {} bytes, {:.2f} bytes/form, {} calls to save, {} calls to load\n", n_bytes,
+                                     static_cast<double>(n_bytes) / n_forms, n_save_calls, n_load_calls);
+        }
+    }
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,204 @@
+#include "Host/Bench.h"
+#include "Papyrus.h"
+
+// A script that needs n forms: n calls of a scalar native against one call of its *Many variant, both through the
+// stand-in VM, which marshals arguments and results per call like the real one. One sample is the whole request.
+//   FetchCreate      new forms of one base, the previous request's forms deleted untimed in between
+//   Fetch            forms already held, by custom id
+//   EditCustomID     a custom id per form
+//   GetFormSet       the formsets of n bases
+//   Delete           forms created untimed before each request
+// Time spent waiting for the VM to schedule the call is not part of it; that only adds to every crossing saved.
+//
+//   dft_papyrus_bench [--csv path] [samples]
+
+namespace {
+
+    using RE::BSScript::Variable;
+
+    constexpr std::array<std::size_t, 4> kBatchSizes{1, 10, 50, 128};
+
+    struct Base {
+        FormID formid;
+        std::string editorid;
+        RE::TESForm* form;
+    };
+
+    class PapyrusBench {
+    public:
+        explicit PapyrusBench(const std::size_t a_samples) : samples(a_samples) {
+            auto& registry = Host::FormRegistry::Get();
+            for (std::size_t b = 0; b < kBatchSizes.back(); ++b) {
+                const auto formid = static_cast<FormID>(0x00050000 + b);
+                auto editorid = std::format("DFTPapyrusMisc{}", b);
+                auto* form = registry.AddBase<RE::TESObjectMISC>(formid, editorid, std::format("Papyrus Misc {}", b));
+                bases.push_back({formid, std::move(editorid), form});
+            }
+            tracker = std::make_unique<DynamicFormTracker>();
+            DFT = tracker.get();
+            Papyrus::Register(&vm);
+        }
+
+        ~PapyrusBench() {
+            DFT = nullptr;
+            tracker.reset();
+            Host::FormRegistry::Get().Clear();
+        }
+
+        void Run(std::vector<Host::Bench::Result>& a_results) {
+            for (const auto n : kBatchSizes) {
+                _fetch_create(n, a_results);
+                _fetch(n, a_results);
+                _edit_custom_id(n, a_results);
+                _get_form_set(n, a_results);
+                _delete(n, a_results);
+            }
+        }
+
+    private:
+        Variable _call(const std::string_view a_name, std::initializer_list<Variable> a_args) const {
+            return vm.CallStatic(Papyrus::script_name, a_name, std::span(a_args.begin(), a_args.size()));
+        }
+
+        static Variable _ints(const std::size_t a_n, const std::int32_t a_first = 0) {
+            Variable::Array array;
+            for (std::size_t i = 0; i < a_n; ++i) array.emplace_back(static_cast<std::int32_t>(a_first + i));
+            return array;
+        }
+
+        static Variable _forms(const std::vector<FormID>& a_formids) {
+            Variable::Array array;
+            for (const auto formid : a_formids) array.emplace_back(RE::TESForm::LookupByID(formid));
+            return array;
+        }
+
+        std::vector<FormID> _create(const Base& a_base, const std::size_t a_n, const std::optional<std::uint32_t> a_first_customID = {}) {
+            std::vector<std::optional<std::uint32_t>> customIDs;
+            if (a_first_customID) {
+                for (std::size_t i = 0; i < a_n; ++i) customIDs.push_back(*a_first_customID + static_cast<std::uint32_t>(i));
+            }
+            return tracker->FetchCreateMany<RE::TESBoundObject>(a_base.formid, a_base.editorid, a_n, customIDs);
+        }
+
+        void _compare(const std::string_view a_op, const std::size_t a_n, Host::Bench::Result a_scalar,
+                      Host::Bench::Result a_batch, std::vector<Host::Bench::Result>& a_results) {
+            a_scalar.name = std::format("{} x{} scalar", a_op, a_n);
+            a_batch.name = std::format("{} x{} batch", a_op, a_n);
+            Host::Bench::Print(a_scalar);
+            Host::Bench::Print(a_batch);
+            std::cout << std::format("  {} crossings -> 1, p50 scalar/batch {:.2f}\n", a_n,
+                                     a_batch.p50_ns > 0. ? a_scalar.p50_ns / a_batch.p50_ns : 0.);
+            a_results.push_back(std::move(a_scalar));
+            a_results.push_back(std::move(a_batch));
+        }
+
+        void _fetch_create(const std::size_t n, std::vector<Host::Bench::Result>& a_results) {
+            const auto& base = bases.front();
+            const auto release = [&](std::size_t) {
+                std::vector<FormID> formids;
+                tracker->CopyFormSets({&base.form, 1}, formids);
+                tracker->Delete(formids);
+            };
+            auto scalar = Host::Bench::Run(
+                "", samples,
+                [&](std::size_t) {
+                    for (std::size_t i = 0; i < n; ++i) _call("FetchCreate", {base.form, -1});
+                },
+                release);
+            auto batch = Host::Bench::Run(
+                "", samples,
+                [&](std::size_t) { _call("FetchCreateMany", {base.form, static_cast<std::int32_t>(n), Variable::Array{}}); },
+                release);
+            release(0);
+            _compare("FetchCreate", n, std::move(scalar), std::move(batch), a_results);
+        }
+
+        void _fetch(const std::size_t n, std::vector<Host::Bench::Result>& a_results) {
+            const auto& base = bases.front();
+            const auto formids = _create(base, n, 0);
+            auto scalar = Host::Bench::Run("", samples, [&](std::size_t) {
+                for (std::size_t i = 0; i < n; ++i) _call("Fetch", {base.form, static_cast<std::int32_t>(i)});
+            });
+            const auto customIDs = _ints(n);
+            auto batch = Host::Bench::Run("", samples, [&](std::size_t) {
+                _call("FetchMany", {base.form, static_cast<std::int32_t>(n), customIDs});
+            });
+            tracker->Delete(formids);
+            _compare("Fetch", n, std::move(scalar), std::move(batch), a_results);
+        }
+
+        void _edit_custom_id(const std::size_t n, std::vector<Host::Bench::Result>& a_results) {
+            const auto& base = bases.front();
+            const auto formids = _create(base, n);
+            std::vector<RE::TESForm*> forms;
+            for (const auto formid : formids) forms.push_back(RE::TESForm::LookupByID(formid));
+            auto scalar = Host::Bench::Run("", samples, [&](const std::size_t k) {
+                for (std::size_t i = 0; i < n; ++i) {
+                    _call("EditCustomID", {forms[i], static_cast<std::int32_t>(k * n + i)});
+                }
+            });
+            auto batch = Host::Bench::Run("", samples, [&](const std::size_t k) {
+                _call("EditCustomIDs", {_forms(formids), _ints(n, static_cast<std::int32_t>(k * n))});
+            });
+            tracker->Delete(formids);
+            _compare("EditCustomID", n, std::move(scalar), std::move(batch), a_results);
+        }
+
+        void _get_form_set(const std::size_t n, std::vector<Host::Bench::Result>& a_results) {
+            std::vector<FormID> formids;
+            Variable::Array base_forms;
+            for (std::size_t b = 0; b < n; ++b) {
+                std::ranges::copy(_create(bases[b], 4), std::back_inserter(formids));
+                base_forms.emplace_back(bases[b].form);
+            }
+            auto scalar = Host::Bench::Run("", samples, [&](std::size_t) {
+                for (std::size_t b = 0; b < n; ++b) _call("GetFormSet", {bases[b].form});
+            });
+            const Variable base_array(base_forms);
+            auto batch = Host::Bench::Run("", samples, [&](std::size_t) {
+                _call("GetFormSets", {base_array});
+                _call("GetFormSetCounts", {base_array});
+            });
+            tracker->Delete(formids);
+            _compare("GetFormSet", n, std::move(scalar), std::move(batch), a_results);
+        }
+
+        void _delete(const std::size_t n, std::vector<Host::Bench::Result>& a_results) {
+            const auto& base = bases.front();
+            std::vector<FormID> formids;
+            const auto create = [&](std::size_t) { formids = _create(base, n); };
+            auto scalar = Host::Bench::Run(
+                "", samples,
+                [&](std::size_t) {
+                    for (const auto formid : formids) _call("Delete", {RE::TESForm::LookupByID(formid)});
+                },
+                create);
+            auto batch = Host::Bench::Run(
+                "", samples, [&](std::size_t) { _call("DeleteMany", {_forms(formids)}); }, create);
+            _compare("Delete", n, std::move(scalar), std::move(batch), a_results);
+        }
+
+        std::size_t samples;
+        std::vector<Base> bases;
+        std::unique_ptr<DynamicFormTracker> tracker;
+        RE::BSScript::IVirtualMachine vm;
+    };
+};
+
+int main(int argc, char** argv) {
+    spdlog::set_level(spdlog::level::err);
+
+    std::optional<std::filesystem::path> csv;
+    if (argc > 2 && std::string_view(argv[1]) == "--csv") {
+        csv = argv[2];
+        argc -= 2;
+        argv += 2;
+    }
+    const std::size_t samples = argc > 1 ? std::stoul(argv[1]) : 200;
+
+    std::vector<Host::Bench::Result> results;
+    Host::Bench::PrintHeader();
+    PapyrusBench(samples).Run(results);
+    if (csv) Host::Bench::WriteCSV(*csv, results);
+    return 0;
+}
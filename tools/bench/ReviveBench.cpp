@@ -0,0 +1,129 @@
+#include "Host/Bench.h"
+#include "DynamicFormTracker.h"
+
+// Revive throughput per form type: the copier FormReviver generates for the type at compile time, against the
+// dynamic cast per component path that fakes of another type than their base still take. Both start from a fresh
+// Copy of the base, as ReviveDynamicForm does, onto fakes made by the type's factory. Every fake revived by the
+// compiled copier is checked against one revived by casts, so the two stay interchangeable.
+//
+//   dft_revive_bench [--csv path] [forms_per_type]
+
+namespace {
+
+    // every component the form has, filled with something to copy
+    void Populate(RE::TESForm* a_form, RE::TESForm* a_keyword) {
+        if (auto* c = a_form->As<RE::TESDescription>()) c->description = "A description long enough not to be inline.";
+        if (auto* c = a_form->As<RE::BGSKeywordForm>()) c->keywords.assign(4, a_keyword);
+        if (auto* c = a_form->As<RE::BGSPickupPutdownSounds>()) c->pickupSound = c->putdownSound = a_keyword;
+        if (auto* c = a_form->As<RE::TESModelTextureSwap>()) c->alternateTextures = {"Textures\\Bench\\Alt_d.dds"};
+        if (auto* c = a_form->As<RE::TESModel>()) c->model = "Meshes\\Bench\\BenchObject01.nif";
+        if (auto* c = a_form->As<RE::BGSMessageIcon>()) c->icon.textureName = "Interface\\Bench\\Message.dds";
+        if (auto* c = a_form->As<RE::TESIcon>()) c->textureName = "Interface\\Bench\\Icon.dds";
+        if (auto* c = a_form->As<RE::TESValueForm>()) c->value = 125;
+        if (auto* c = a_form->As<RE::TESWeightForm>()) c->weight = 2.5f;
+        if (auto* c = a_form->As<RE::BGSDestructibleObjectForm>()) c->health = 40;
+        if (auto* c = a_form->As<RE::TESEnchantableForm>()) c->amountofEnchantment = 500;
+        if (auto* c = a_form->As<RE::BGSBlockBashData>()) c->blockBashImpactDataSet = a_keyword;
+        if (auto* c = a_form->As<RE::BGSEquipType>()) c->equipSlot = a_keyword;
+        if (auto* c = a_form->As<RE::TESAttackDamageForm>()) c->attackDamage = 12;
+        if (auto* c = a_form->As<RE::TESBipedModelForm>()) c->worldModels[0].model = "Meshes\\Bench\\World_0.nif";
+        if (auto* c = a_form->As<RE::TESObjectWEAP>()) c->weaponData.speed = 1.1f;
+        if (auto* c = a_form->As<RE::TESObjectBOOK>()) c->inventoryModel = a_keyword;
+        if (auto* c = a_form->As<RE::TESAmmo>()) c->GetRuntimeData().data.damage = 9.f;
+    }
+
+    // what a revive is expected to have copied
+    std::string Fingerprint(RE::TESForm* a_form) {
+        std::string out = a_form->GetName();
+        if (const auto* c = a_form->As<RE::TESDescription>()) out += "|" + c->description;
+        if (const auto* c = a_form->As<RE::BGSKeywordForm>()) out += std::format("|k{}", c->keywords.size());
+        if (const auto* c = a_form->As<RE::TESModel>()) out += "|" + c->model;
+        if (const auto* c = a_form->As<RE::TESModelTextureSwap>()) out += std::format("|t{}", c->alternateTextures.size());
+        if (const auto* c = a_form->As<RE::BGSMessageIcon>()) out += "|" + c->icon.textureName;
+        if (const auto* c = a_form->As<RE::TESIcon>()) out += "|" + c->textureName;
+        if (const auto* c = a_form->As<RE::TESValueForm>()) out += std::format("|v{}", c->value);
+        if (const auto* c = a_form->As<RE::TESWeightForm>()) out += std::format("|w{}", c->weight);
+        if (const auto* c = a_form->As<RE::BGSDestructibleObjectForm>()) out += std::format("|h{}", c->health);
+        if (const auto* c = a_form->As<RE::TESEnchantableForm>()) out += std::format("|e{}", c->amountofEnchantment);
+        if (const auto* c = a_form->As<RE::BGSEquipType>()) out += std::format("|s{}", c->equipSlot != nullptr);
+        if (const auto* c = a_form->As<RE::TESAttackDamageForm>()) out += std::format("|d{}", c->attackDamage);
+        if (const auto* c = a_form->As<RE::TESBipedModelForm>()) out += "|" + c->worldModels[0].model;
+        if (const auto* c = a_form->As<RE::TESObjectWEAP>()) out += std::format("|sp{}", c->weaponData.speed);
+        if (const auto* c = a_form->As<RE::TESObjectBOOK>()) out += std::format("|im{}", c->inventoryModel != nullptr);
+        return out;
+    }
+
+    std::size_t n_mismatches = 0;
+
+    template <class Form>
+    void RunType(const std::size_t a_n, RE::TESForm* a_keyword, std::vector<Host::Bench::Result>& a_results) {
+        auto& registry = Host::FormRegistry::Get();
+        const auto type_name = RE::FormTypeToString(Form::FORMTYPE);
+        auto* base = registry.AddBase<Form>(0x00060000 + std::to_underlying(Form::FORMTYPE),
+                                            std::format("DFTRevive{}", type_name), std::format("Revive {}", type_name));
+        Populate(base, a_keyword);
+
+        auto* factory = RE::IFormFactory::GetFormFactoryByType(Form::FORMTYPE);
+        std::vector<RE::TESForm*> by_plan;
+        std::vector<RE::TESForm*> by_casts;
+        for (std::size_t i = 0; i < a_n; ++i) {
+            by_plan.push_back(factory->Create());
+            by_casts.push_back(factory->Create());
+        }
+
+        const auto copier = FormReviver::Get(Form::FORMTYPE);
+        auto plan = Host::Bench::Run(std::format("{} compiled", type_name), a_n, [&](const std::size_t i) {
+            by_plan[i]->Copy(base);
+            copier(base, by_plan[i]);
+        });
+        auto casts = Host::Bench::Run(std::format("{} casts", type_name), a_n, [&](const std::size_t i) {
+            by_casts[i]->Copy(base);
+            FormReviver::ReviveByCasts(by_casts[i], base);
+        });
+
+        const auto expected = Fingerprint(by_casts.front());
+        for (std::size_t i = 0; i < a_n; ++i) {
+            if (Fingerprint(by_plan[i]) != expected || Fingerprint(by_casts[i]) != expected) n_mismatches++;
+        }
+        if (expected != Fingerprint(base)) {
+            std::cerr << std::format("{}: revived {} but the base is {}\n", type_name, expected, Fingerprint(base));
+            n_mismatches++;
+        }
+
+        Host::Bench::Print(plan);
+        Host::Bench::Print(casts);
+        std::cout << std::format("  p50 casts/compiled {:.2f}\n", plan.p50_ns > 0. ? casts.p50_ns / plan.p50_ns : 0.);
+        a_results.push_back(std::move(plan));
+        a_results.push_back(std::move(casts));
+    }
+
+    template <class... Forms>
+    void RunAll(const std::size_t a_n, RE::TESForm* a_keyword, std::vector<Host::Bench::Result>& a_results,
+                std::type_identity<std::tuple<Forms...>>) {
+        (RunType<Forms>(a_n, a_keyword, a_results), ...);
+    }
+};
+
+int main(int argc, char** argv) {
+    spdlog::set_level(spdlog::level::err);
+
+    std::optional<std::filesystem::path> csv;
+    if (argc > 2 && std::string_view(argv[1]) == "--csv") {
+        csv = argv[2];
+        argc -= 2;
+        argv += 2;
+    }
+    const std::size_t n = argc > 1 ? std::stoul(argv[1]) : 10'000;
+
+    auto& registry = Host::FormRegistry::Get();
+    auto* keyword = registry.AddBase<RE::TESObjectMISC>(0x0005FFFF, "DFTReviveKeyword");
+
+    std::vector<Host::Bench::Result> results;
+    Host::Bench::PrintHeader();
+    RunAll(n, keyword, results, std::type_identity<FormReviver::Forms>{});
+    registry.Clear();
+
+    if (csv) Host::Bench::WriteCSV(*csv, results);
+    if (n_mismatches) std::cerr << std::format("{} fakes revived differently by the two paths\n", n_mismatches);
+    return n_mismatches ? 1 : 0;
+}
@@ -0,0 +1,195 @@
+#include "Host/Bench.h"
+#include "DynamicFormTracker.h"
+
+// The tracker's hot paths against the stand-in registry and factories, over a few shapes of tracker. A scenario is
+// bases x forms per base, the share of forms the player holds (active) and the share that carries a custom id.
+// One run goes through a session the way the game drives it:
+//   create            Prewarm of one form, new forms from the factory
+//   edit custom id    EditCustomID per form that gets one
+//   fetch custom id   Fetch by custom id, for the active forms that have one
+//   fetch pooled      Fetch without one, served from the inactive pool
+//   get by custom id  GetByCustomID, read only
+//   save              SendData + Save of the whole cosave record; the first encodes every base, later ones
+//                     reuse the cached blocks of clean bases
+//   load              Reset + Load + ReceiveData of that record
+//   revalidate        RevalidateStale with a 100 us budget, one op per frame
+//   delete inactives  DeleteInactives with a 100 us budget, one op per frame
+//
+//   dft_tracker_bench [--csv path] [bases forms_per_base active_ratio customid_ratio]
+
+namespace {
+
+    struct Scenario {
+        std::size_t n_bases;
+        std::size_t forms_per_base;
+        double active_ratio;
+        double customid_ratio;
+
+        [[nodiscard]] std::string Name() const {
+            return std::format("{}x{} a={:.2f} c={:.2f}", n_bases, forms_per_base, active_ratio, customid_ratio);
+        }
+    };
+
+    constexpr std::uint32_t kRecordType = 0x44465454;  // DFTT
+    constexpr auto kFrameBudget = std::chrono::microseconds(100);
+
+    struct Base {
+        FormID formid;
+        std::string editorid;
+        RE::TESObjectMISC* form;
+    };
+
+    // deterministic and independent per salt, so the active and the custom id shares do not line up
+    bool Pick(const std::size_t a_index, const double a_ratio, const std::uint64_t a_salt) {
+        auto x = static_cast<std::uint64_t>(a_index) ^ a_salt;
+        x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+        x ^= x >> 31;
+        return static_cast<double>(x % 10'000) < a_ratio * 10'000.;
+    }
+
+    constexpr std::uint64_t kCustomIDSalt = 0xC0FFEE;
+    constexpr std::uint64_t kActiveSalt = 0xAC7;
+
+    void RunScenario(const Scenario& a_scenario, std::vector<Host::Bench::Result>& a_results) {
+        auto& registry = Host::FormRegistry::Get();
+        registry.Clear();
+
+        std::vector<Base> bases;
+        for (std::size_t b = 0; b < a_scenario.n_bases; ++b) {
+            const auto formid = static_cast<FormID>(0x00020000 + b);
+            auto editorid = std::format("DFTBenchMisc{}", b);
+            auto* form = registry.AddBase<RE::TESObjectMISC>(formid, editorid, std::format("Bench Misc {}", b));
+            form->value = static_cast<std::int32_t>(b);
+            form->weight = .5f;
+            form->model = "Clutter\\BenchMisc.nif";
+            bases.push_back({formid, std::move(editorid), form});
+        }
+
+        auto tracker = std::make_unique<DynamicFormTracker>();
+        const auto n_forms = a_scenario.n_bases * a_scenario.forms_per_base;
+        const auto prefix = a_scenario.Name();
+        const auto record = [&](Host::Bench::Result a_result) {
+            a_result.name = std::format("[{}] {}", prefix, a_result.name);
+            Host::Bench::Print(a_result);
+            a_results.push_back(std::move(a_result));
+        };
+        const auto base_of = [&](const std::size_t i) -> const Base& { return bases[i % bases.size()]; };
+
+        record(Host::Bench::Run("create", n_forms, [&](const std::size_t i) {
+            tracker->Prewarm(base_of(i).editorid, SIZE_MAX, 1);
+        }));
+
+        // form i is the (i / bases)th form of base i % bases
+        std::vector<FormID> formids(n_forms, 0);
+        for (std::size_t b = 0; b < bases.size(); ++b) {
+            std::size_t k = 0;
+            tracker->ForEachInFormSet(bases[b].formid, bases[b].editorid,
+                                      [&](const FormID formid) { formids[k++ * bases.size() + b] = formid; });
+        }
+
+        std::vector<std::size_t> with_customid;
+        for (std::size_t i = 0; i < n_forms; ++i) {
+            if (Pick(i, a_scenario.customid_ratio, kCustomIDSalt)) with_customid.push_back(i);
+        }
+        record(Host::Bench::Run("edit custom id", with_customid.size(), [&](const std::size_t k) {
+            const auto i = with_customid[k];
+            tracker->EditCustomID(formids[i], static_cast<std::uint32_t>(i));
+        }));
+
+        // the forms the player ends up holding, by custom id where they have one
+        std::vector<std::size_t> fetch_customid;
+        std::vector<std::size_t> fetch_pooled;
+        for (std::size_t i = 0; i < n_forms; ++i) {
+            if (!Pick(i, a_scenario.active_ratio, kActiveSalt)) continue;
+            (Pick(i, a_scenario.customid_ratio, kCustomIDSalt) ? fetch_customid : fetch_pooled).push_back(i);
+        }
+        const auto fetch_active = [&](const bool a_timed) {
+            const auto by_customid = [&](const std::size_t k) {
+                const auto i = fetch_customid[k];
+                tracker->Fetch(base_of(i).formid, base_of(i).editorid, static_cast<std::uint32_t>(i));
+            };
+            const auto pooled = [&](const std::size_t k) {
+                const auto& base = base_of(fetch_pooled[k]);
+                tracker->Fetch(base.formid, base.editorid, std::nullopt);
+            };
+            if (!a_timed) {
+                for (std::size_t k = 0; k < fetch_customid.size(); ++k) by_customid(k);
+                for (std::size_t k = 0; k < fetch_pooled.size(); ++k) pooled(k);
+                return;
+            }
+            record(Host::Bench::Run("fetch custom id", fetch_customid.size(), by_customid));
+            record(Host::Bench::Run("fetch pooled", fetch_pooled.size(), pooled));
+        };
+        fetch_active(true);
+
+        std::size_t n_found = 0;
+        record(Host::Bench::Run("get by custom id", with_customid.size(), [&](const std::size_t k) {
+            const auto i = with_customid[k];
+            if (tracker->GetByCustomID(static_cast<std::uint32_t>(i), base_of(i).formid, base_of(i).editorid)) n_found++;
+        }));
+        if (n_found != with_customid.size()) {
+            std::cerr << std::format("{}: found {} of {} custom ids\n", prefix, n_found, with_customid.size());
+        }
+
+        SKSE::SerializationInterface intfc;
+        record(Host::Bench::Run(
+            "save", 5,
+            [&](std::size_t) {
+                tracker->SendData();
+                if (!tracker->Save(&intfc, kRecordType, Utilities::Types::kDFSaveVersion)) {
+                    std::cerr << std::format("{}: save failed\n", prefix);
+                }
+            },
+            [&](std::size_t) { intfc = {}; }));
+        const auto n_bytes = intfc.Bytes().size();
+
+        record(Host::Bench::Run(
+            "load", 5,
+            [&](std::size_t) {
+                std::uint32_t type = 0;
+                std::uint32_t version = 0;
+                std::uint32_t length = 0;
+                tracker->Reset();
+                if (!intfc.GetNextRecordInfo(type, version, length) || !tracker->Load(&intfc, version)) {
+                    std::cerr << std::format("{}: load failed\n", prefix);
+                }
+                tracker->ReceiveData();
+            },
+            [&](std::size_t) { intfc.Rewind(); }));
+
+        record(Host::Bench::RunUntilDone("revalidate", [&] { return tracker->RevalidateStale(kFrameBudget); }));
+
+        fetch_active(false);
+        const auto n_inactive = n_forms - fetch_customid.size() - fetch_pooled.size();
+        record(Host::Bench::RunUntilDone("delete inactives", [&] { return tracker->DeleteInactives(kFrameBudget); }));
+
+        const auto [pool_hits, pool_misses] = tracker->GetPoolHitsMisses();
+        std::cout << std::format("  {} forms, {} bytes saved, {} of {} inactive forms swept, pool hits/misses {}/{}\n",
+                                 n_forms, n_bytes, tracker->GetNSwept(), n_inactive, pool_hits, pool_misses);
+        tracker.reset();
+        registry.Clear();
+    }
+};
+
+int main(int argc, char** argv) {
+    spdlog::set_level(spdlog::level::err);
+
+    std::optional<std::filesystem::path> csv;
+    if (argc > 2 && std::string_view(argv[1]) == "--csv") {
+        csv = argv[2];
+        argc -= 2;
+        argv += 2;
+    }
+
+    std::vector<Scenario> scenarios{{10, 100, .5, .25}, {1000, 10, .5, .25}, {10, 10'000, .1, 0.}, {100, 1000, .9, 1.}};
+    if (argc > 4) {
+        scenarios = {{std::stoul(argv[1]), std::stoul(argv[2]), std::stod(argv[3]), std::stod(argv[4])}};
+    }
+
+    std::vector<Host::Bench::Result> results;
+    Host::Bench::PrintHeader();
+    for (const auto& scenario : scenarios) RunScenario(scenario, results);
+    if (csv) Host::Bench::WriteCSV(*csv, results);
+    return 0;
+}
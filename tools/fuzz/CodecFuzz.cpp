@@ -0,0 +1,154 @@
+#include "Utils.h"
+
+// Feeds arbitrary bytes to Load as the payload of one cosave record. The first byte picks the record version, the
+// rest is the payload. Whatever Load keeps has to save again in the current layout.
+//
+// Built with clang and DFT_LIBFUZZER this is a plain libFuzzer target. Otherwise the main below drives it: it saves
+// a few valid records in every layout and mutates them by truncating, flipping bits, planting extreme u32 values and
+// duplicating ranges. The run is deterministic for a given seed.
+//
+//   dft_codec_fuzz [iterations] [seed]
+//   dft_codec_fuzz <input files...>     replays inputs, e.g. a crash found by libFuzzer
+
+namespace {
+
+    constexpr std::uint32_t kRecordType = 0x44465446;  // DFTF
+
+    class FuzzData : public Utilities::DFSaveLoadData {
+    public:
+        const char* GetType() override { return "CodecFuzz"; }
+
+        void Fill(const std::size_t a_nBases, const std::size_t a_formsPerBase) {
+            FormID next = 0xFF000800;
+            for (std::size_t base = 0; base < a_nBases; ++base) {
+                auto& rhs = m_Data[{static_cast<FormID>(0x00010000 + base),
+                                    m_EditorIDs.Intern(std::format("FuzzBase{}", base))}];
+                for (std::size_t i = 0; i < a_formsPerBase; ++i) {
+                    rhs.push_back({next++, {i % 2 == 0, static_cast<std::uint32_t>(i)}, i % 3 == 0 ? 2.f : -1.f});
+                }
+            }
+        }
+    };
+};
+
+extern "C" int LLVMFuzzerInitialize(int*, char***) {
+    spdlog::set_level(spdlog::level::off);
+    return 0;
+}
+
+extern "C" int LLVMFuzzerTestOneInput(const std::uint8_t* a_data, const std::size_t a_size) {
+    if (!a_size) return 0;
+    const auto version = a_data[0] & 1 ? Utilities::Types::kDFSaveVersion2 : Utilities::Types::kDFSaveVersion1;
+    const auto length = static_cast<std::uint32_t>(a_size - 1);
+
+    std::vector<std::uint8_t> bytes(3 * sizeof(std::uint32_t));
+    std::memcpy(bytes.data(), &kRecordType, sizeof(std::uint32_t));
+    std::memcpy(bytes.data() + 4, &version, sizeof(std::uint32_t));
+    std::memcpy(bytes.data() + 8, &length, sizeof(std::uint32_t));
+    bytes.insert(bytes.end(), a_data + 1, a_data + a_size);
+
+    SKSE::SerializationInterface intfc(std::move(bytes));
+    std::uint32_t type = 0;
+    std::uint32_t read_version = 0;
+    std::uint32_t read_length = 0;
+    if (!intfc.GetNextRecordInfo(type, read_version, read_length)) return 0;
+
+    FuzzData data;
+    (void)data.Load(&intfc, read_version);
+
+    SKSE::SerializationInterface out;
+    if (!data.Save(&out, kRecordType, Utilities::Types::kDFSaveVersion)) __builtin_trap();
+    return 0;
+}
+
+#ifndef DFT_LIBFUZZER
+
+namespace {
+
+    // version byte + record payload, as LLVMFuzzerTestOneInput takes it
+    std::vector<std::vector<std::uint8_t>> MakeSeeds() {
+        std::vector<std::vector<std::uint8_t>> seeds;
+        for (const auto& [n_bases, forms_per_base] : {std::pair{1uz, 1uz}, {3uz, 5uz}, {2uz, 40uz}}) {
+            FuzzData data;
+            data.Fill(n_bases, forms_per_base);
+            for (const auto& [version, compress] :
+                 {std::pair{Utilities::Types::kDFSaveVersion1, false},
+                  {Utilities::Types::kDFSaveVersion2, false}, {Utilities::Types::kDFSaveVersion2, true}}) {
+                data.SetCompression(compress);
+                SKSE::SerializationInterface intfc;
+                if (!data.Save(&intfc, kRecordType, version)) continue;
+                const auto& bytes = intfc.Bytes();
+                std::vector<std::uint8_t> seed{static_cast<std::uint8_t>(version == Utilities::Types::kDFSaveVersion2)};
+                seed.insert(seed.end(), bytes.begin() + 3 * sizeof(std::uint32_t), bytes.end());
+                seeds.push_back(std::move(seed));
+            }
+        }
+        return seeds;
+    }
+
+    void Mutate(std::vector<std::uint8_t>& a_input, std::mt19937& a_rng) {
+        constexpr std::array<std::uint32_t, 6> kExtremes{0, 1, 0x7F, 0x7FFFFFFF, 0x80000000, 0xFFFFFFFF};
+        const auto pick = [&](const std::size_t a_n) { return std::uniform_int_distribution<std::size_t>(0, a_n - 1)(a_rng); };
+
+        const auto n_mutations = 1 + pick(4);
+        for (std::size_t m = 0; m < n_mutations && a_input.size() > 1; ++m) {
+            switch (pick(4)) {
+                case 0:
+                    a_input.resize(1 + pick(a_input.size()));
+                    break;
+                case 1:
+                    a_input[1 + pick(a_input.size() - 1)] ^= static_cast<std::uint8_t>(1u << pick(8));
+                    break;
+                case 2: {
+                    if (a_input.size() < 1 + sizeof(std::uint32_t)) break;
+                    const auto value = kExtremes[pick(kExtremes.size())];
+                    std::memcpy(a_input.data() + 1 + pick(a_input.size() - sizeof(std::uint32_t)), &value,
+                                sizeof(value));
+                    break;
+                }
+                default: {
+                    const auto from = 1 + pick(a_input.size() - 1);
+                    const auto len = 1 + pick(std::min<std::size_t>(64, a_input.size() - from));
+                    const std::vector<std::uint8_t> range(a_input.begin() + from, a_input.begin() + from + len);
+                    a_input.insert(a_input.begin() + 1 + pick(a_input.size() - 1), range.begin(), range.end());
+                    break;
+                }
+            }
+        }
+    }
+
+    bool IsNumber(const std::string_view a_arg) {
+        return !a_arg.empty() && std::ranges::all_of(a_arg, [](const char c) { return c >= '0' && c <= '9'; });
+    }
+};
+
+int main(const int argc, char** argv) {
+    LLVMFuzzerInitialize(nullptr, nullptr);
+
+    if (argc > 1 && !IsNumber(argv[1])) {
+        for (int i = 1; i < argc; ++i) {
+            std::ifstream file(argv[i], std::ios::binary);
+            const std::vector<std::uint8_t> input{std::istreambuf_iterator<char>(file), {}};
+            LLVMFuzzerTestOneInput(input.data(), input.size());
+            std::cout << std::format("{}: {} bytes, ok\n", argv[i], input.size());
+        }
+        return 0;
+    }
+
+    const std::size_t iterations = argc > 1 ? std::stoul(argv[1]) : 100'000;
+    const auto seed = argc > 2 ? static_cast<std::uint32_t>(std::stoul(argv[2])) : 0x5EEDu;
+    std::mt19937 rng(seed);
+
+    const auto seeds = MakeSeeds();
+    for (const auto& input : seeds) LLVMFuzzerTestOneInput(input.data(), input.size());
+
+    for (std::size_t i = 0; i < iterations; ++i) {
+        auto input = seeds[i % seeds.size()];
+        Mutate(input, rng);
+        LLVMFuzzerTestOneInput(input.data(), input.size());
+    }
+    std::cout << std::format("{} seeds, {} mutated inputs, seed {}: no crashes\n", seeds.size(), iterations, seed);
+    return 0;
+}
+
+#endif
@@ -0,0 +1,8 @@
+#pragma once
+
+// Host stand-in for clib_util's editorID helpers. In game the editorid comes from po3's Tweaks; here the stand-in
+// forms carry it themselves.
+namespace clib_util::editorID {
+
+    inline std::string get_editorID(const RE::TESForm* a_form) { return a_form ? a_form->GetFormEditorID() : ""; }
+};
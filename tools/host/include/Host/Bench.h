@@ -0,0 +1,149 @@
+#pragma once
+
+// Shared by the host benchmarks: a global allocation counter, per-op timing and the results table.
+// Replaces every global operator new and delete, so include it from the one translation unit of a benchmark executable.
+namespace Host::Bench {
+
+    inline std::atomic<std::uint64_t> n_allocs = 0;
+
+    [[nodiscard]] inline std::uint64_t GetNAllocs() { return n_allocs.load(std::memory_order_relaxed); }
+
+    struct Result {
+        std::string name;
+        std::size_t n_ops = 0;
+        double seconds = 0.;
+        double p50_ns = 0.;
+        double p99_ns = 0.;
+        double allocs_per_op = 0.;
+
+        [[nodiscard]] double OpsPerSec() const { return seconds > 0. ? static_cast<double>(n_ops) / seconds : 0.; }
+    };
+
+    // exact percentile of the samples, which get sorted
+    inline double Percentile(std::vector<std::uint64_t>& a_samples, const double a_q) {
+        if (a_samples.empty()) return 0.;
+        std::ranges::sort(a_samples);
+        const auto idx = std::min(a_samples.size() - 1, static_cast<std::size_t>(a_q * a_samples.size()));
+        return static_cast<double>(a_samples[idx]);
+    }
+
+    inline Result Summarize(std::string a_name, std::vector<std::uint64_t>& a_samples, const std::uint64_t a_allocs) {
+        Result result{std::move(a_name), a_samples.size()};
+        for (const auto sample : a_samples) result.seconds += static_cast<double>(sample) * 1e-9;
+        result.p50_ns = Percentile(a_samples, .5);
+        result.p99_ns = Percentile(a_samples, .99);
+        result.allocs_per_op = a_samples.empty() ? 0. : static_cast<double>(a_allocs) / a_samples.size();
+        return result;
+    }
+
+    // Times a_op(i) for i in [0, a_n), every call on its own. The clock reads add some tens of ns to each sample,
+    // which matters only for the cheapest ops. a_setup runs untimed before each call.
+    template <class Op, class Setup>
+    Result Run(std::string a_name, const std::size_t a_n, Op&& a_op, Setup&& a_setup) {
+        using clock = std::chrono::steady_clock;
+        std::vector<std::uint64_t> samples;
+        samples.reserve(a_n);
+        std::uint64_t allocs = 0;
+        for (std::size_t i = 0; i < a_n; ++i) {
+            a_setup(i);
+            const auto allocs_before = GetNAllocs();
+            const auto start = clock::now();
+            a_op(i);
+            const auto end = clock::now();
+            allocs += GetNAllocs() - allocs_before;
+            samples.push_back(std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count());
+        }
+        return Summarize(std::move(a_name), samples, allocs);
+    }
+
+    template <class Op>
+    Result Run(std::string a_name, const std::size_t a_n, Op&& a_op) {
+        return Run(std::move(a_name), a_n, std::forward<Op>(a_op), [](std::size_t) {});
+    }
+
+    // for work spread over frames: calls a_op() until it returns 0, one sample per call
+    template <class Op>
+    Result RunUntilDone(std::string a_name, Op&& a_op) {
+        using clock = std::chrono::steady_clock;
+        std::vector<std::uint64_t> samples;
+        std::uint64_t allocs = 0;
+        for (bool done = false; !done;) {
+            const auto allocs_before = GetNAllocs();
+            const auto start = clock::now();
+            done = a_op() == 0;
+            const auto end = clock::now();
+            allocs += GetNAllocs() - allocs_before;
+            samples.push_back(std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count());
+        }
+        return Summarize(std::move(a_name), samples, allocs);
+    }
+
+    inline void PrintHeader(std::ostream& a_out = std::cout) {
+        a_out << std::format("{:<48} {:>10} {:>14} {:>12} {:>12} {:>12}\n", "op", "n", "ops/s", "p50 ns", "p99 ns",
+                             "allocs/op");
+    }
+
+    inline void Print(const Result& a_result, std::ostream& a_out = std::cout) {
+        a_out << std::format("{:<48} {:>10} {:>14.0f} {:>12.0f} {:>12.0f} {:>12.2f}\n", a_result.name, a_result.n_ops,
+                             a_result.OpsPerSec(), a_result.p50_ns, a_result.p99_ns, a_result.allocs_per_op);
+    }
+
+    inline void WriteCSV(const std::filesystem::path& a_path, const std::vector<Result>& a_results) {
+        std::ofstream out(a_path);
+        out << "op,n,ops_per_sec,p50_ns,p99_ns,allocs_per_op\n";
+        for (const auto& r : a_results) {
+            out << std::format("{},{},{:.1f},{:.1f},{:.1f},{:.3f}\n", r.name, r.n_ops, r.OpsPerSec(), r.p50_ns,
+                               r.p99_ns, r.allocs_per_op);
+        }
+    }
+};
+
+namespace Host::Bench::detail {
+    // every replaced operator new comes through here and every operator delete frees with std::free
+    inline void* Allocate(const std::size_t a_size, const std::size_t a_align = __STDCPP_DEFAULT_NEW_ALIGNMENT__) {
+        n_allocs.fetch_add(1, std::memory_order_relaxed);
+        const auto size = a_size ? a_size : 1;
+        if (a_align <= __STDCPP_DEFAULT_NEW_ALIGNMENT__) return std::malloc(size);
+        return std::aligned_alloc(a_align, (size + a_align - 1) / a_align * a_align);
+    }
+
+    inline void* AllocateOrThrow(const std::size_t a_size,
+                                 const std::size_t a_align = __STDCPP_DEFAULT_NEW_ALIGNMENT__) {
+        if (void* ptr = Allocate(a_size, a_align)) return ptr;
+        throw std::bad_alloc();
+    }
+};
+
+void* operator new(const std::size_t a_size) { return Host::Bench::detail::AllocateOrThrow(a_size); }
+void* operator new[](const std::size_t a_size) { return Host::Bench::detail::AllocateOrThrow(a_size); }
+void* operator new(const std::size_t a_size, const std::nothrow_t&) noexcept {
+    return Host::Bench::detail::Allocate(a_size);
+}
+void* operator new[](const std::size_t a_size, const std::nothrow_t&) noexcept {
+    return Host::Bench::detail::Allocate(a_size);
+}
+void* operator new(const std::size_t a_size, const std::align_val_t a_align) {
+    return Host::Bench::detail::AllocateOrThrow(a_size, static_cast<std::size_t>(a_align));
+}
+void* operator new[](const std::size_t a_size, const std::align_val_t a_align) {
+    return Host::Bench::detail::AllocateOrThrow(a_size, static_cast<std::size_t>(a_align));
+}
+void* operator new(const std::size_t a_size, const std::align_val_t a_align, const std::nothrow_t&) noexcept {
+    return Host::Bench::detail::Allocate(a_size, static_cast<std::size_t>(a_align));
+}
+void* operator new[](const std::size_t a_size, const std::align_val_t a_align, const std::nothrow_t&) noexcept {
+    return Host::Bench::detail::Allocate(a_size, static_cast<std::size_t>(a_align));
+}
+
+void operator delete(void* a_ptr) noexcept { std::free(a_ptr); }
+void operator delete[](void* a_ptr) noexcept { std::free(a_ptr); }
+void operator delete(void* a_ptr, std::size_t) noexcept { std::free(a_ptr); }
+void operator delete[](void* a_ptr, std::size_t) noexcept { std::free(a_ptr); }
+void operator delete(void* a_ptr, const std::nothrow_t&) noexcept { std::free(a_ptr); }
+void operator delete[](void* a_ptr, const std::nothrow_t&) noexcept { std::free(a_ptr); }
+void operator delete(void* a_ptr, std::align_val_t) noexcept { std::free(a_ptr); }
+void operator delete[](void* a_ptr, std::align_val_t) noexcept { std::free(a_ptr); }
+void operator delete(void* a_ptr, std::size_t, std::align_val_t) noexcept { std::free(a_ptr); }
+void operator delete[](void* a_ptr, std::size_t, std::align_val_t) noexcept { std::free(a_ptr); }
+void operator delete(void* a_ptr, std::align_val_t, const std::nothrow_t&) noexcept { std::free(a_ptr); }
+void operator delete[](void* a_ptr, std::align_val_t, const std::nothrow_t&) noexcept { std::free(a_ptr); }
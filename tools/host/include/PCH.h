@@ -0,0 +1,58 @@
+#pragma once
+
+// Host counterpart of include/PCH.h: the same prelude, built against the stand-ins next to this file.
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cassert>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <random>
+#include <ranges>
+#include <regex>
+#include <set>
+#include <shared_mutex>
+#include <span>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <tuple>
+#include <type_traits>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <variant>
+#include <vector>
+
+#if __has_include(<format>)
+    #include <format>
+#else
+    // GCC 12 ships no <format>; the tracker headers only need std::format itself
+    #include <fmt/format.h>
+namespace std {
+    using fmt::format;
+}
+#endif
+
+#include <spdlog/spdlog.h>
+
+#include "RE/Skyrim.h"
+#include "SKSE/SKSE.h"
+
+namespace logger = SKSE::log;
+using namespace std::literals;
+
+using FormID = RE::FormID;
@@ -0,0 +1,1050 @@
+#pragma once
+
+// Host stand-in for the parts of CommonLibSSE-NG the tracker headers use. Class and member names follow CommonLib so
+// the headers in include/ compile unchanged; the layouts do not. Forms live in Host::FormRegistry instead of the
+// engine's form maps, and As<T> is a dynamic_cast.
+namespace Host {
+    class FormRegistry;
+};
+
+namespace RE {
+
+    using FormID = std::uint32_t;
+
+    enum class FormType : std::uint8_t {
+        None = 0,
+        Keyword = 4,
+        MagicEffect = 18,
+        Enchantment = 21,
+        Spell = 22,
+        Scroll = 23,
+        Armor = 26,
+        Book = 27,
+        Ingredient = 30,
+        Light = 31,
+        Misc = 32,
+        Weapon = 41,
+        Ammo = 42,
+        KeyMaster = 45,
+        AlchemyItem = 46,
+        SoulGem = 52,
+        Reference = 61,
+        ActorCharacter = 62
+    };
+
+    constexpr std::string_view FormTypeToString(const FormType a_type) {
+        switch (a_type) {
+            case FormType::Keyword:
+                return "KYWD";
+            case FormType::MagicEffect:
+                return "MGEF";
+            case FormType::Enchantment:
+                return "ENCH";
+            case FormType::Spell:
+                return "SPEL";
+            case FormType::Scroll:
+                return "SCRL";
+            case FormType::Armor:
+                return "ARMO";
+            case FormType::Book:
+                return "BOOK";
+            case FormType::Ingredient:
+                return "INGR";
+            case FormType::Light:
+                return "LIGH";
+            case FormType::Misc:
+                return "MISC";
+            case FormType::Weapon:
+                return "WEAP";
+            case FormType::Ammo:
+                return "AMMO";
+            case FormType::KeyMaster:
+                return "KEYM";
+            case FormType::AlchemyItem:
+                return "ALCH";
+            case FormType::SoulGem:
+                return "SLGM";
+            case FormType::Reference:
+                return "REFR";
+            case FormType::ActorCharacter:
+                return "ACHR";
+            default:
+                return "NONE";
+        }
+    }
+
+    class TESForm {
+    public:
+        inline static constexpr auto FORMTYPE = FormType::None;
+
+        explicit TESForm(const FormType a_type = FORMTYPE) : formType(a_type) {}
+        TESForm(const TESForm&) = delete;
+        TESForm& operator=(const TESForm&) = delete;
+        virtual ~TESForm();
+
+        virtual void Copy(TESForm*) {}
+
+        [[nodiscard]] FormID GetFormID() const { return formID; }
+        [[nodiscard]] FormType GetFormType() const { return formType; }
+        [[nodiscard]] const char* GetName() const;
+        [[nodiscard]] const char* GetFormEditorID() const { return editorID.c_str(); }
+
+        // re-registers the form under the new id, like the engine's SetFormID
+        void SetFormID(FormID a_id, bool a_updateFile);
+
+        template <class T>
+        [[nodiscard]] T* As() noexcept {
+            return dynamic_cast<T*>(this);
+        }
+
+        template <class T>
+        [[nodiscard]] const T* As() const noexcept {
+            return dynamic_cast<const T*>(this);
+        }
+
+        static TESForm* LookupByID(FormID a_formID);
+        static TESForm* LookupByEditorID(std::string_view a_editorID);
+
+        template <class T>
+        static T* LookupByID(const FormID a_formID) {
+            auto* form = LookupByID(a_formID);
+            return form ? form->As<T>() : nullptr;
+        }
+
+        template <class T>
+        static T* LookupByEditorID(const std::string_view a_editorID) {
+            auto* form = LookupByEditorID(a_editorID);
+            return form ? form->As<T>() : nullptr;
+        }
+
+        // host only: what po3's Tweaks would report
+        std::string editorID;
+
+    private:
+        friend class Host::FormRegistry;
+
+        FormID formID = 0;
+        FormType formType;
+    };
+
+    // components. CopyComponent copies the component's own fields from a component of the same type.
+
+    class BaseFormComponent {
+    public:
+        virtual ~BaseFormComponent() = default;
+        virtual void CopyComponent(BaseFormComponent*) {}
+    };
+
+    class TESFullName : public BaseFormComponent {
+    public:
+        void CopyComponent(BaseFormComponent* a_rhs) override {
+            if (const auto* rhs = dynamic_cast<TESFullName*>(a_rhs)) fullName = rhs->fullName;
+        }
+
+        std::string fullName;
+    };
+
+    class TESModel : public BaseFormComponent {
+    public:
+        void CopyComponent(BaseFormComponent* a_rhs) override {
+            if (const auto* rhs = dynamic_cast<TESModel*>(a_rhs)) model = rhs->model;
+        }
+
+        std::string model;
+    };
+
+    class TESModelTextureSwap : public TESModel {
+    public:
+        void CopyComponent(BaseFormComponent* a_rhs) override {
+            if (const auto* rhs = dynamic_cast<TESModelTextureSwap*>(a_rhs)) {
+                model = rhs->model;
+                alternateTextures = rhs->alternateTextures;
+            }
+        }
+
+        std::vector<std::string> alternateTextures;
+    };
+
+    class TESIcon : public BaseFormComponent {
+    public:
+        void CopyComponent(BaseFormComponent* a_rhs) override {
+            if (const auto* rhs = dynamic_cast<TESIcon*>(a_rhs)) textureName = rhs->textureName;
+        }
+
+        std::string textureName;
+    };
+
+    class BGSMessageIcon : public BaseFormComponent {
+    public:
+        void CopyComponent(BaseFormComponent* a_rhs) override {
+            if (const auto* rhs = dynamic_cast<BGSMessageIcon*>(a_rhs)) icon.textureName = rhs->icon.textureName;
+        }
+
+        TESIcon icon;
+    };
+
+    class TESValueForm : public BaseFormComponent {
+    public:
+        void CopyComponent(BaseFormComponent* a_rhs) override {
+            if (const auto* rhs = dynamic_cast<TESValueForm*>(a_rhs)) value = rhs->value;
+        }
+
+        std::int32_t value = 0;
+    };
+
+    class TESWeightForm : public BaseFormComponent {
+    public:
+        void CopyComponent(BaseFormComponent* a_rhs) override {
+            if (const auto* rhs = dynamic_cast<TESWeightForm*>(a_rhs)) weight = rhs->weight;
+        }
+
+        float weight = 0.f;
+    };
+
+    class TESDescription : public BaseFormComponent {
+    public:
+        void CopyComponent(BaseFormComponent* a_rhs) override {
+            if (const auto* rhs = dynamic_cast<TESDescription*>(a_rhs)) description = rhs->description;
+        }
+
+        std::string description;
+    };
+
+    class BGSKeywordForm : public BaseFormComponent {
+    public:
+        void CopyComponent(BaseFormComponent* a_rhs) override {
+            if (const auto* rhs = dynamic_cast<BGSKeywordForm*>(a_rhs)) keywords = rhs->keywords;
+        }
+
+        std::vector<TESForm*> keywords;
+    };
+
+    class BGSPickupPutdownSounds : public BaseFormComponent {
+    public:
+        void CopyComponent(BaseFormComponent* a_rhs) override {
+            if (const auto* rhs = dynamic_cast<BGSPickupPutdownSounds*>(a_rhs)) {
+                pickupSound = rhs->pickupSound;
+                putdownSound = rhs->putdownSound;
+            }
+        }
+
+        TESForm* pickupSound = nullptr;
+        TESForm* putdownSound = nullptr;
+    };
+
+    class BGSDestructibleObjectForm : public BaseFormComponent {
+    public:
+        void CopyComponent(BaseFormComponent* a_rhs) override {
+            if (const auto* rhs = dynamic_cast<BGSDestructibleObjectForm*>(a_rhs)) health = rhs->health;
+        }
+
+        std::int32_t health = 0;
+    };
+
+    class TESEnchantableForm : public BaseFormComponent {
+    public:
+        void CopyComponent(BaseFormComponent* a_rhs) override {
+            if (const auto* rhs = dynamic_cast<TESEnchantableForm*>(a_rhs)) {
+                formEnchanting = rhs->formEnchanting;
+                amountofEnchantment = rhs->amountofEnchantment;
+            }
+        }
+
+        TESForm* formEnchanting = nullptr;
+        std::uint16_t amountofEnchantment = 0;
+    };
+
+    class BGSBlockBashData : public BaseFormComponent {
+    public:
+        void CopyComponent(BaseFormComponent* a_rhs) override {
+            if (const auto* rhs = dynamic_cast<BGSBlockBashData*>(a_rhs)) {
+                blockBashImpactDataSet = rhs->blockBashImpactDataSet;
+                altBlockMaterialType = rhs->altBlockMaterialType;
+            }
+        }
+
+        TESForm* blockBashImpactDataSet = nullptr;
+        TESForm* altBlockMaterialType = nullptr;
+    };
+
+    class BGSEquipType : public BaseFormComponent {
+    public:
+        void CopyComponent(BaseFormComponent* a_rhs) override {
+            if (const auto* rhs = dynamic_cast<BGSEquipType*>(a_rhs)) equipSlot = rhs->equipSlot;
+        }
+
+        TESForm* equipSlot = nullptr;
+    };
+
+    class TESAttackDamageForm : public BaseFormComponent {
+    public:
+        void CopyComponent(BaseFormComponent* a_rhs) override {
+            if (const auto* rhs = dynamic_cast<TESAttackDamageForm*>(a_rhs)) attackDamage = rhs->attackDamage;
+        }
+
+        std::uint16_t attackDamage = 0;
+    };
+
+    class TESBipedModelForm : public BaseFormComponent {
+    public:
+        void CopyComponent(BaseFormComponent* a_rhs) override {
+            if (const auto* rhs = dynamic_cast<TESBipedModelForm*>(a_rhs)) {
+                for (std::size_t i = 0; i < 2; ++i) {
+                    worldModels[i].CopyComponent(const_cast<TESModelTextureSwap*>(&rhs->worldModels[i]));
+                    inventoryIcons[i].CopyComponent(const_cast<TESIcon*>(&rhs->inventoryIcons[i]));
+                }
+            }
+        }
+
+        TESModelTextureSwap worldModels[2];
+        TESIcon inventoryIcons[2];
+    };
+
+    class BGSMenuDisplayObject : public BaseFormComponent {
+    public:
+        void CopyComponent(BaseFormComponent* a_rhs) override {
+            if (const auto* rhs = dynamic_cast<BGSMenuDisplayObject*>(a_rhs)) menuDispObject = rhs->menuDispObject;
+        }
+
+        TESForm* menuDispObject = nullptr;
+    };
+
+    // forms. the component lists follow CommonLib's class declarations.
+
+    class TESBoundObject : public TESForm {
+    public:
+        using TESForm::TESForm;
+    };
+
+    class TESObjectWEAP : public TESBoundObject,
+                          public TESFullName,
+                          public TESModelTextureSwap,
+                          public TESIcon,
+                          public TESEnchantableForm,
+                          public TESValueForm,
+                          public TESWeightForm,
+                          public TESAttackDamageForm,
+                          public BGSDestructibleObjectForm,
+                          public BGSEquipType,
+                          public BGSMessageIcon,
+                          public BGSPickupPutdownSounds,
+                          public BGSBlockBashData,
+                          public BGSKeywordForm,
+                          public TESDescription {
+    public:
+        inline static constexpr auto FORMTYPE = FormType::Weapon;
+
+        struct Data {
+            float speed = 1.f;
+            float reach = 1.f;
+            std::uint16_t flags = 0;
+            std::uint8_t animationType = 0;
+        };
+
+        struct CriticalData {
+            float prcntMult = 1.f;
+            TESForm* effect = nullptr;
+            std::uint16_t damage = 0;
+        };
+
+        TESObjectWEAP() : TESBoundObject(FORMTYPE) {}
+
+        Data weaponData;
+        CriticalData criticalData;
+        TESForm* firstPersonModelObject = nullptr;
+        TESForm* attackSound = nullptr;
+        TESForm* attackSound2D = nullptr;
+        TESForm* attackFailSound = nullptr;
+        TESForm* idleSound = nullptr;
+        TESForm* equipSound = nullptr;
+        TESForm* unequipSound = nullptr;
+        TESForm* impactDataSet = nullptr;
+        std::uint32_t soundLevel = 0;
+        TESObjectWEAP* templateWeapon = nullptr;
+        std::string embeddedNode;
+    };
+
+    class TESObjectARMO : public TESBoundObject,
+                          public TESFullName,
+                          public TESEnchantableForm,
+                          public TESValueForm,
+                          public TESWeightForm,
+                          public BGSDestructibleObjectForm,
+                          public BGSPickupPutdownSounds,
+                          public TESBipedModelForm,
+                          public BGSEquipType,
+                          public BGSBlockBashData,
+                          public BGSKeywordForm,
+                          public TESDescription {
+    public:
+        inline static constexpr auto FORMTYPE = FormType::Armor;
+
+        TESObjectARMO() : TESBoundObject(FORMTYPE) {}
+
+        std::vector<TESForm*> armorAddons;
+    };
+
+    class TESObjectBOOK : public TESBoundObject,
+                          public TESFullName,
+                          public TESModelTextureSwap,
+                          public TESIcon,
+                          public TESValueForm,
+                          public TESWeightForm,
+                          public TESDescription,
+                          public BGSDestructibleObjectForm,
+                          public BGSMessageIcon,
+                          public BGSPickupPutdownSounds,
+                          public BGSKeywordForm {
+    public:
+        inline static constexpr auto FORMTYPE = FormType::Book;
+
+        struct Data {
+            struct Teaches {
+                TESForm* spell = nullptr;
+                std::uint32_t actorValueToAdvance = 0;
+            };
+
+            std::uint8_t flags = 0;
+            std::uint8_t type = 0;
+            Teaches teaches;
+        };
+
+        TESObjectBOOK() : TESBoundObject(FORMTYPE) {}
+
+        Data data;
+        TESForm* inventoryModel = nullptr;
+        TESDescription itemCardDescription;
+    };
+
+    class TESAmmo : public TESBoundObject,
+                    public TESFullName,
+                    public TESModelTextureSwap,
+                    public TESIcon,
+                    public BGSMessageIcon,
+                    public TESValueForm,
+                    public TESWeightForm,
+                    public BGSDestructibleObjectForm,
+                    public BGSPickupPutdownSounds,
+                    public TESDescription,
+                    public BGSKeywordForm {
+    public:
+        inline static constexpr auto FORMTYPE = FormType::Ammo;
+
+        struct AMMO_DATA {
+            TESForm* projectile = nullptr;
+            std::uint32_t flags = 0;
+            float damage = 0.f;
+        };
+
+        struct RUNTIME_DATA {
+            AMMO_DATA data;
+            std::string shortDesc;
+        };
+
+        TESAmmo() : TESBoundObject(FORMTYPE) {}
+
+        [[nodiscard]] RUNTIME_DATA& GetRuntimeData() { return runtimeData; }
+        [[nodiscard]] const RUNTIME_DATA& GetRuntimeData() const { return runtimeData; }
+
+    private:
+        RUNTIME_DATA runtimeData;
+    };
+
+    class TESObjectMISC : public TESBoundObject,
+                          public TESFullName,
+                          public TESModelTextureSwap,
+                          public TESIcon,
+                          public TESValueForm,
+                          public TESWeightForm,
+                          public BGSDestructibleObjectForm,
+                          public BGSMessageIcon,
+                          public BGSPickupPutdownSounds,
+                          public BGSKeywordForm {
+    public:
+        inline static constexpr auto FORMTYPE = FormType::Misc;
+
+        TESObjectMISC() : TESObjectMISC(FORMTYPE) {}
+
+    protected:
+        explicit TESObjectMISC(const FormType a_type) : TESBoundObject(a_type) {}
+    };
+
+    class TESKey : public TESObjectMISC {
+    public:
+        inline static constexpr auto FORMTYPE = FormType::KeyMaster;
+
+        TESKey() : TESObjectMISC(FORMTYPE) {}
+    };
+
+    class TESSoulGem : public TESObjectMISC {
+    public:
+        inline static constexpr auto FORMTYPE = FormType::SoulGem;
+
+        TESSoulGem() : TESObjectMISC(FORMTYPE) {}
+
+        std::uint8_t currentSoul = 0;
+        std::uint8_t soulCapacity = 0;
+    };
+
+    class TESObjectLIGT : public TESBoundObject,
+                          public TESFullName,
+                          public TESModelTextureSwap,
+                          public TESIcon,
+                          public BGSMessageIcon,
+                          public TESWeightForm,
+                          public TESValueForm,
+                          public BGSDestructibleObjectForm,
+                          public BGSEquipType {
+    public:
+        inline static constexpr auto FORMTYPE = FormType::Light;
+
+        TESObjectLIGT() : TESBoundObject(FORMTYPE) {}
+    };
+
+    class MagicItem : public TESBoundObject, public TESFullName, public BGSKeywordForm {
+    public:
+        using TESBoundObject::TESBoundObject;
+
+        [[nodiscard]] bool IsPoison() const { return poison; }
+        [[nodiscard]] bool IsFood() const { return food; }
+        [[nodiscard]] bool IsMedicine() const { return medicine; }
+
+        // host only: what the engine reads from the item's data flags
+        bool poison = false;
+        bool food = false;
+        bool medicine = false;
+    };
+
+    class AlchemyItem : public MagicItem,
+                        public TESModelTextureSwap,
+                        public TESIcon,
+                        public BGSMessageIcon,
+                        public TESWeightForm,
+                        public BGSEquipType,
+                        public BGSDestructibleObjectForm,
+                        public BGSPickupPutdownSounds {
+    public:
+        inline static constexpr auto FORMTYPE = FormType::AlchemyItem;
+
+        AlchemyItem() : MagicItem(FORMTYPE) {}
+    };
+
+    class IngredientItem : public MagicItem,
+                           public TESModelTextureSwap,
+                           public TESIcon,
+                           public TESWeightForm,
+                           public TESValueForm,
+                           public BGSDestructibleObjectForm,
+                           public BGSPickupPutdownSounds {
+    public:
+        inline static constexpr auto FORMTYPE = FormType::Ingredient;
+
+        IngredientItem() : MagicItem(FORMTYPE) {}
+    };
+
+    class SpellItem : public MagicItem, public BGSEquipType, public BGSMenuDisplayObject, public TESDescription {
+    public:
+        inline static constexpr auto FORMTYPE = FormType::Spell;
+
+        SpellItem() : SpellItem(FORMTYPE) {}
+
+    protected:
+        explicit SpellItem(const FormType a_type) : MagicItem(a_type) {}
+    };
+
+    class ScrollItem : public SpellItem,
+                       public TESModelTextureSwap,
+                       public BGSDestructibleObjectForm,
+                       public BGSPickupPutdownSounds,
+                       public TESWeightForm,
+                       public TESValueForm {
+    public:
+        inline static constexpr auto FORMTYPE = FormType::Scroll;
+
+        ScrollItem() : SpellItem(FORMTYPE) {}
+    };
+
+    class EnchantmentItem : public MagicItem {
+    public:
+        inline static constexpr auto FORMTYPE = FormType::Enchantment;
+
+        EnchantmentItem() : MagicItem(FORMTYPE) {}
+    };
+
+    class EffectSetting : public TESForm, public TESFullName, public BGSMenuDisplayObject, public BGSKeywordForm {
+    public:
+        inline static constexpr auto FORMTYPE = FormType::MagicEffect;
+
+        struct EffectSettingData {
+            TESForm* light = nullptr;
+            TESForm* effectShader = nullptr;
+            TESForm* enchantShader = nullptr;
+            TESForm* projectileBase = nullptr;
+            TESForm* explosion = nullptr;
+            TESForm* castingArt = nullptr;
+            TESForm* hitEffectArt = nullptr;
+            TESForm* impactDataSet = nullptr;
+            TESForm* enchantEffectArt = nullptr;
+            TESForm* hitVisuals = nullptr;
+            TESForm* enchantVisuals = nullptr;
+            TESForm* imageSpaceMod = nullptr;
+        };
+
+        EffectSetting() : TESForm(FORMTYPE) {}
+
+        EffectSettingData data;
+        std::vector<TESForm*> effectSounds;
+    };
+
+    class TESObjectREFR : public TESForm {
+    public:
+        inline static constexpr auto FORMTYPE = FormType::Reference;
+
+        TESObjectREFR() : TESObjectREFR(FORMTYPE) {}
+
+    protected:
+        explicit TESObjectREFR(const FormType a_type) : TESForm(a_type) {}
+    };
+
+    class Actor;
+
+    class ActiveEffect {
+    public:
+        MagicItem* spell = nullptr;
+        float elapsedSeconds = 0.f;
+        float duration = 0.f;
+    };
+
+    class MagicTarget {
+    public:
+        [[nodiscard]] std::list<ActiveEffect*>* GetActiveEffectList() { return &activeEffects; }
+
+    private:
+        friend class MagicCaster;
+
+        std::list<ActiveEffect*> activeEffects;
+        std::list<ActiveEffect> storage;
+    };
+
+    namespace MagicSystem {
+        enum class CastingSource : std::uint32_t { kLeftHand, kRightHand, kOther, kInstant };
+    };
+
+    // casting puts one effect with a fixed duration on the target
+    class MagicCaster {
+    public:
+        explicit MagicCaster(MagicTarget& a_target) : target(a_target) {}
+
+        void CastSpellImmediate(MagicItem* a_spell, bool, TESObjectREFR*, float, bool, float, Actor*) {
+            auto& effect = target.storage.emplace_back(a_spell, 0.f, kDuration);
+            target.activeEffects.push_back(&effect);
+        }
+
+        static constexpr float kDuration = 60.f;
+
+    private:
+        MagicTarget& target;
+    };
+
+    enum class ITEM_REMOVE_REASON : std::uint32_t { kRemove, kSteal, kSelling, kDropping };
+
+    class ExtraDataList;
+
+    class InventoryEntryData {};
+
+    class Actor : public TESObjectREFR {
+    public:
+        inline static constexpr auto FORMTYPE = FormType::ActorCharacter;
+
+        using InventoryItemMap = std::map<TESBoundObject*, std::pair<std::int32_t, std::unique_ptr<InventoryEntryData>>>;
+
+        Actor() : TESObjectREFR(FORMTYPE) {}
+
+        [[nodiscard]] MagicTarget* AsMagicTarget() { return &magicTarget; }
+        [[nodiscard]] MagicCaster* GetMagicCaster(MagicSystem::CastingSource) { return &magicCaster; }
+
+        [[nodiscard]] InventoryItemMap GetInventory(const std::function<bool(TESBoundObject&)>& a_filter) const {
+            InventoryItemMap result;
+            for (const auto& [object, count] : inventory) {
+                if (a_filter(*object)) result.emplace(object, std::pair{count, std::make_unique<InventoryEntryData>()});
+            }
+            return result;
+        }
+
+        void AddObjectToContainer(TESBoundObject* a_object, ExtraDataList*, const std::int32_t a_count, TESObjectREFR*) {
+            inventory[a_object] += a_count;
+        }
+
+        void RemoveItem(TESBoundObject* a_item, const std::int32_t a_count, ITEM_REMOVE_REASON, ExtraDataList*,
+                        TESObjectREFR*) {
+            const auto it = inventory.find(a_item);
+            if (it == inventory.end()) return;
+            if ((it->second -= a_count) <= 0) inventory.erase(it);
+        }
+
+    private:
+        std::map<TESBoundObject*, std::int32_t> inventory;
+        MagicTarget magicTarget;
+        MagicCaster magicCaster{magicTarget};
+    };
+
+    // never registered and never freed, so it outlives the registry at exit
+    class PlayerCharacter : public Actor {
+    public:
+        static PlayerCharacter* GetSingleton() {
+            static auto* singleton = new PlayerCharacter;
+            return singleton;
+        }
+    };
+
+    // Create hands out a form with the next dynamic formid, as the engine's factories do
+    class IFormFactory {
+    public:
+        virtual ~IFormFactory() = default;
+        virtual TESForm* Create() = 0;
+
+        static IFormFactory* GetFormFactoryByType(FormType a_type);
+    };
+
+    template <class T>
+    class ConcreteFormFactory : public IFormFactory {
+    public:
+        TESForm* Create() override;
+    };
+
+    // message boxes, only so Utils.h compiles; nothing is shown
+
+    template <class T>
+    using BSTSmartPointer = std::shared_ptr<T>;
+
+    template <class T, class... Args>
+    BSTSmartPointer<T> make_smart(Args&&... a_args) {
+        return std::make_shared<T>(std::forward<Args>(a_args)...);
+    }
+
+    class IMessageBoxCallback {
+    public:
+        enum class Message : std::uint8_t { kUnk0, kUnk1, kUnk2, kUnk3, kUnk4 };
+
+        virtual ~IMessageBoxCallback() = default;
+        virtual void Run(Message a_msg) = 0;
+    };
+
+    class MessageBoxData {
+    public:
+        void QueueMessage() { delete this; }
+
+        BSTSmartPointer<IMessageBoxCallback> callback;
+        std::string bodyText;
+        std::vector<std::string> buttonText;
+    };
+
+    class MessageDataFactoryManager {
+    public:
+        template <class T>
+        struct Creator {
+            T* Create() { return new T; }
+        };
+
+        static MessageDataFactoryManager* GetSingleton() {
+            static MessageDataFactoryManager singleton;
+            return &singleton;
+        }
+
+        template <class T>
+        Creator<T>* GetCreator(const std::string_view) {
+            static Creator<T> creator;
+            return &creator;
+        }
+    };
+
+    class InterfaceStrings {
+    public:
+        static InterfaceStrings* GetSingleton() {
+            static InterfaceStrings singleton;
+            return &singleton;
+        }
+
+        std::string messageBoxData = "MessageBoxData";
+    };
+
+    inline void DebugMessageBox(const char* a_message) { spdlog::info("[message box] {}", a_message); }
+
+    // Papyrus: the VM only as far as a script calling a registered native goes
+
+    struct StaticFunctionTag {};
+
+    namespace BSScript {
+
+        // a script value. Arrays hold their elements as values too, so they are copied element by element on the
+        // way into and out of a native, as BSScrArray contents are.
+        struct Variable {
+            using Array = std::vector<Variable>;
+
+            Variable() = default;
+            Variable(const std::int32_t a_value) : value(a_value) {}
+            Variable(const bool a_value) : value(a_value) {}
+            Variable(TESForm* a_value) : value(a_value) {}
+            Variable(Array a_value) : value(std::move(a_value)) {}
+
+            std::variant<std::monostate, std::int32_t, bool, TESForm*, Array> value;
+        };
+
+        template <class T>
+        struct Marshal {
+            static T Unpack(const Variable& a_var) { return std::get<T>(a_var.value); }
+            static Variable Pack(T a_value) { return Variable(a_value); }
+        };
+
+        template <class T>
+        struct Marshal<std::vector<T>> {
+            static std::vector<T> Unpack(const Variable& a_var) {
+                const auto& array = std::get<Variable::Array>(a_var.value);
+                std::vector<T> result;
+                result.reserve(array.size());
+                for (const auto& element : array) result.push_back(Marshal<T>::Unpack(element));
+                return result;
+            }
+
+            static Variable Pack(const std::vector<T>& a_value) {
+                Variable::Array array;
+                array.reserve(a_value.size());
+                for (const auto& element : a_value) array.push_back(Marshal<T>::Pack(element));
+                return Variable(std::move(array));
+            }
+        };
+
+        class IVirtualMachine {
+        public:
+            // Each native is kept behind one type-erased entry that unpacks the arguments to its parameter types,
+            // calls it and packs the result, which is the per call work the real VM does for a static native.
+            template <class R, class... Args>
+            bool RegisterFunction(const std::string_view a_name, const std::string_view a_className,
+                                  R (*a_fn)(StaticFunctionTag*, Args...), bool = false) {
+                auto& natives = classes[std::string(a_className)];
+                natives[std::string(a_name)] = [a_fn](const std::span<const Variable> a_args) -> Variable {
+                    if (a_args.size() != sizeof...(Args)) return {};
+                    return [&]<std::size_t... I>(std::index_sequence<I...>) -> Variable {
+                        if constexpr (std::is_void_v<R>) {
+                            a_fn(nullptr, Marshal<std::remove_cvref_t<Args>>::Unpack(a_args[I])...);
+                            return {};
+                        } else {
+                            return Marshal<std::remove_cvref_t<R>>::Pack(
+                                a_fn(nullptr, Marshal<std::remove_cvref_t<Args>>::Unpack(a_args[I])...));
+                        }
+                    }(std::index_sequence_for<Args...>{});
+                };
+                return true;
+            }
+
+            // host only: a script calling a_className.a_name(a_args). None if no such native is registered.
+            Variable CallStatic(const std::string_view a_className, const std::string_view a_name,
+                                const std::span<const Variable> a_args) const {
+                const auto class_it = classes.find(a_className);
+                if (class_it == classes.end()) return {};
+                const auto native_it = class_it->second.find(a_name);
+                return native_it != class_it->second.end() ? native_it->second(a_args) : Variable{};
+            }
+
+        private:
+            struct StringHash {
+                using is_transparent = void;
+                std::size_t operator()(const std::string_view a_str) const noexcept {
+                    return std::hash<std::string_view>{}(a_str);
+                }
+            };
+
+            template <class T>
+            using StringMap = std::unordered_map<std::string, T, StringHash, std::equal_to<>>;
+
+            StringMap<StringMap<std::function<Variable(std::span<const Variable>)>>> classes;
+        };
+    };
+};
+
+namespace Host {
+
+    // Stand-in for the engine's form maps. Forms made by the stand-in factories get ids from the dynamic range,
+    // counting up from 0xFF000800 like the engine's; deleting a form unregisters it.
+    class FormRegistry {
+    public:
+        static FormRegistry& Get() {
+            static FormRegistry registry;
+            return registry;
+        }
+
+        // a form from a plugin, with a fixed id and an editorid
+        template <class T>
+        T* AddBase(const RE::FormID a_formID, const std::string_view a_editorID, const std::string_view a_name = {}) {
+            auto* form = new T;
+            form->editorID = a_editorID;
+            if constexpr (std::is_base_of_v<RE::TESFullName, T>) form->fullName = a_name;
+            Register(form, a_formID);
+            return form;
+        }
+
+        // AddBase for a type only known at runtime, e.g. one read from a trace. nullptr if no factory makes the type.
+        RE::TESForm* AddBase(const RE::FormType a_type, const RE::FormID a_formID, const std::string_view a_editorID,
+                             const std::string_view a_name = {}) {
+            auto* factory = RE::IFormFactory::GetFormFactoryByType(a_type);
+            if (!factory) return nullptr;
+            auto* form = factory->Create();
+            Unregister(form);
+            form->editorID = a_editorID;
+            if (auto* fullName = form->As<RE::TESFullName>()) fullName->fullName = a_name;
+            Register(form, a_formID);
+            return form;
+        }
+
+        // a form made at runtime: next id of the dynamic range, no editorid
+        void AddDynamic(RE::TESForm* a_form) {
+            std::unique_lock lock(mutex);
+            a_form->formID = next_dynamic++;
+            by_id[a_form->formID] = a_form;
+        }
+
+        void Register(RE::TESForm* a_form, const RE::FormID a_formID) {
+            std::unique_lock lock(mutex);
+            a_form->formID = a_formID;
+            by_id[a_formID] = a_form;
+            if (!a_form->editorID.empty()) by_editorid[a_form->editorID] = a_form;
+        }
+
+        void Unregister(const RE::TESForm* a_form) {
+            std::unique_lock lock(mutex);
+            if (const auto it = by_id.find(a_form->formID); it != by_id.end() && it->second == a_form) by_id.erase(it);
+            if (!a_form->editorID.empty()) {
+                const auto it = by_editorid.find(a_form->editorID);
+                if (it != by_editorid.end() && it->second == a_form) by_editorid.erase(it);
+            }
+        }
+
+        // the engine simply overwrites whatever held the new id
+        void Move(RE::TESForm* a_form, const RE::FormID a_formID) {
+            std::unique_lock lock(mutex);
+            if (const auto it = by_id.find(a_form->formID); it != by_id.end() && it->second == a_form) by_id.erase(it);
+            a_form->formID = a_formID;
+            by_id[a_formID] = a_form;
+        }
+
+        [[nodiscard]] RE::TESForm* Find(const RE::FormID a_formID) const {
+            std::shared_lock lock(mutex);
+            const auto it = by_id.find(a_formID);
+            return it != by_id.end() ? it->second : nullptr;
+        }
+
+        [[nodiscard]] RE::TESForm* Find(const std::string_view a_editorID) const {
+            std::shared_lock lock(mutex);
+            const auto it = by_editorid.find(a_editorID);
+            return it != by_editorid.end() ? it->second : nullptr;
+        }
+
+        [[nodiscard]] std::size_t Size() const {
+            std::shared_lock lock(mutex);
+            return by_id.size();
+        }
+
+        // deletes every registered form and restarts the dynamic range, e.g. between benchmark runs
+        void Clear() {
+            std::vector<RE::TESForm*> all;
+            {
+                std::unique_lock lock(mutex);
+                for (const auto* form : by_id | std::views::values) all.push_back(const_cast<RE::TESForm*>(form));
+            }
+            for (auto* form : all) delete form;
+            std::unique_lock lock(mutex);
+            by_id.clear();
+            by_editorid.clear();
+            next_dynamic = kFirstDynamic;
+        }
+
+    private:
+        struct StringHash {
+            using is_transparent = void;
+            std::size_t operator()(const std::string_view a_str) const noexcept {
+                return std::hash<std::string_view>{}(a_str);
+            }
+        };
+
+        static constexpr RE::FormID kFirstDynamic = 0xFF000800;
+
+        mutable std::shared_mutex mutex;
+        std::unordered_map<RE::FormID, RE::TESForm*> by_id;
+        std::unordered_map<std::string, RE::TESForm*, StringHash, std::equal_to<>> by_editorid;
+        RE::FormID next_dynamic = kFirstDynamic;
+    };
+};
+
+namespace RE {
+
+    inline TESForm::~TESForm() { Host::FormRegistry::Get().Unregister(this); }
+
+    inline const char* TESForm::GetName() const {
+        const auto* fullName = As<TESFullName>();
+        return fullName ? fullName->fullName.c_str() : "";
+    }
+
+    inline void TESForm::SetFormID(const FormID a_id, bool) { Host::FormRegistry::Get().Move(this, a_id); }
+
+    inline TESForm* TESForm::LookupByID(const FormID a_formID) { return Host::FormRegistry::Get().Find(a_formID); }
+
+    template <class T>
+    TESForm* ConcreteFormFactory<T>::Create() {
+        auto* form = new T;
+        Host::FormRegistry::Get().AddDynamic(form);
+        return form;
+    }
+
+    inline IFormFactory* IFormFactory::GetFormFactoryByType(const FormType a_type) {
+        static ConcreteFormFactory<TESObjectWEAP> weapon;
+        static ConcreteFormFactory<TESObjectARMO> armor;
+        static ConcreteFormFactory<TESObjectBOOK> book;
+        static ConcreteFormFactory<TESAmmo> ammo;
+        static ConcreteFormFactory<TESObjectMISC> misc;
+        static ConcreteFormFactory<TESKey> key;
+        static ConcreteFormFactory<TESSoulGem> soulGem;
+        static ConcreteFormFactory<TESObjectLIGT> light;
+        static ConcreteFormFactory<AlchemyItem> alchemyItem;
+        static ConcreteFormFactory<IngredientItem> ingredient;
+        static ConcreteFormFactory<SpellItem> spell;
+        static ConcreteFormFactory<ScrollItem> scroll;
+        static ConcreteFormFactory<EnchantmentItem> enchantment;
+        static ConcreteFormFactory<EffectSetting> magicEffect;
+        switch (a_type) {
+            case FormType::Weapon:
+                return &weapon;
+            case FormType::Armor:
+                return &armor;
+            case FormType::Book:
+                return &book;
+            case FormType::Ammo:
+                return &ammo;
+            case FormType::Misc:
+                return &misc;
+            case FormType::KeyMaster:
+                return &key;
+            case FormType::SoulGem:
+                return &soulGem;
+            case FormType::Light:
+                return &light;
+            case FormType::AlchemyItem:
+                return &alchemyItem;
+            case FormType::Ingredient:
+                return &ingredient;
+            case FormType::Spell:
+                return &spell;
+            case FormType::Scroll:
+                return &scroll;
+            case FormType::Enchantment:
+                return &enchantment;
+            case FormType::MagicEffect:
+                return &magicEffect;
+            default:
+                return nullptr;
+        }
+    }
+
+    inline TESForm* TESForm::LookupByEditorID(const std::string_view a_editorID) {
+        return Host::FormRegistry::Get().Find(a_editorID);
+    }
+};
@@ -0,0 +1,183 @@
+#pragma once
+
+// Host stand-in for the parts of SKSE the tracker headers use
+namespace REL {
+
+    class Version {
+    public:
+        constexpr Version(const std::uint16_t a_major, const std::uint16_t a_minor, const std::uint16_t a_patch,
+                          const std::uint16_t a_build)
+            : parts{a_major, a_minor, a_patch, a_build} {}
+
+        [[nodiscard]] constexpr std::uint16_t major() const { return parts[0]; }
+        [[nodiscard]] constexpr std::uint16_t minor() const { return parts[1]; }
+        [[nodiscard]] constexpr std::uint16_t patch() const { return parts[2]; }
+        [[nodiscard]] constexpr std::uint16_t build() const { return parts[3]; }
+
+    private:
+        std::array<std::uint16_t, 4> parts;
+    };
+};
+
+namespace SKSE {
+
+    namespace log {
+        using spdlog::critical;
+        using spdlog::debug;
+        using spdlog::error;
+        using spdlog::info;
+        using spdlog::trace;
+        using spdlog::warn;
+
+        inline std::optional<std::filesystem::path> log_directory() { return std::filesystem::temp_directory_path(); }
+    };
+
+    class PluginDeclaration {
+    public:
+        static PluginDeclaration* GetSingleton() {
+            static PluginDeclaration singleton;
+            return &singleton;
+        }
+
+        [[nodiscard]] std::string_view GetName() const { return "DynamicFormTracker"; }
+        [[nodiscard]] REL::Version GetVersion() const { return {0, 1, 0, 0}; }
+    };
+
+    // AddTask queues; the host drives frames itself with RunTasks
+    class TaskInterface {
+    public:
+        void AddTask(std::function<void()> a_task) {
+            std::lock_guard lock(mutex);
+            tasks.push_back(std::move(a_task));
+        }
+
+        // host only: runs what was queued before the call, like one frame would. returns how many ran.
+        std::size_t RunTasks() {
+            std::vector<std::function<void()>> frame;
+            {
+                std::lock_guard lock(mutex);
+                frame.swap(tasks);
+            }
+            for (auto& task : frame) task();
+            return frame.size();
+        }
+
+    private:
+        std::mutex mutex;
+        std::vector<std::function<void()>> tasks;
+    };
+
+    inline TaskInterface* GetTaskInterface() {
+        static TaskInterface singleton;
+        return &singleton;
+    }
+
+    // In-memory cosave. Records are laid out like SKSE's own: u32 type, u32 version, u32 length, then the payload.
+    // Writing appends to the buffer, reading walks it back record by record and never past the current record.
+    // Every Read/WriteRecordData call is counted, since per-call overhead is what the packed record layout removes.
+    class SerializationInterface {
+    public:
+        SerializationInterface() = default;
+        explicit SerializationInterface(std::vector<std::uint8_t> a_bytes) : bytes(std::move(a_bytes)) {}
+
+        bool OpenRecord(const std::uint32_t a_type, const std::uint32_t a_version) {
+            _close_record();
+            record_start = bytes.size();
+            const std::uint32_t length = 0;
+            _append(&a_type, sizeof(a_type));
+            _append(&a_version, sizeof(a_version));
+            _append(&length, sizeof(length));
+            open = true;
+            return true;
+        }
+
+        bool WriteRecordData(const void* a_buf, const std::uint32_t a_length) {
+            n_calls++;
+            if (!open) return false;
+            _append(a_buf, a_length);
+            return true;
+        }
+
+        template <class T>
+            requires(!std::is_pointer_v<T>)
+        bool WriteRecordData(const T& a_data) {
+            return WriteRecordData(std::addressof(a_data), sizeof(T));
+        }
+
+        // skips whatever the previous record left unread, like SKSE does
+        bool GetNextRecordInfo(std::uint32_t& a_type, std::uint32_t& a_version, std::uint32_t& a_length) {
+            _close_record();
+            read_pos = record_end;
+            if (bytes.size() - read_pos < 3 * sizeof(std::uint32_t)) return false;
+            std::memcpy(&a_type, bytes.data() + read_pos, sizeof(a_type));
+            std::memcpy(&a_version, bytes.data() + read_pos + 4, sizeof(a_version));
+            std::memcpy(&a_length, bytes.data() + read_pos + 8, sizeof(a_length));
+            read_pos += 3 * sizeof(std::uint32_t);
+            record_end = read_pos + std::min<std::size_t>(a_length, bytes.size() - read_pos);
+            return true;
+        }
+
+        // returns the number of bytes read, short at the end of the record
+        std::uint32_t ReadRecordData(void* a_buf, const std::uint32_t a_length) {
+            n_calls++;
+            const auto n = static_cast<std::uint32_t>(std::min<std::size_t>(a_length, record_end - read_pos));
+            if (n) std::memcpy(a_buf, bytes.data() + read_pos, n);
+            read_pos += n;
+            return n;
+        }
+
+        template <class T>
+            requires(!std::is_pointer_v<T>)
+        std::uint32_t ReadRecordData(T& a_data) {
+            return ReadRecordData(std::addressof(a_data), sizeof(T));
+        }
+
+        bool ResolveFormID(const std::uint32_t a_oldFormID, std::uint32_t& a_newFormID) const {
+            if (resolve) return resolve(a_oldFormID, a_newFormID);
+            a_newFormID = a_oldFormID;
+            return true;
+        }
+
+        // host only
+
+        [[nodiscard]] const std::vector<std::uint8_t>& Bytes() {
+            _close_record();
+            return bytes;
+        }
+
+        // back to the first record, for reading what was just written
+        void Rewind() {
+            _close_record();
+            read_pos = 0;
+            record_end = 0;
+        }
+
+        [[nodiscard]] std::size_t GetNCalls() const { return n_calls; }
+        void ResetNCalls() { n_calls = 0; }
+
+        // load order changes: maps a saved formid to the current one, or fails. identity when empty.
+        std::function<bool(std::uint32_t, std::uint32_t&)> resolve;
+
+    private:
+        void _append(const void* a_buf, const std::size_t a_length) {
+            if (!a_length) return;
+            const auto* data = static_cast<const std::uint8_t*>(a_buf);
+            bytes.insert(bytes.end(), data, data + a_length);
+        }
+
+        // patches the length of the record being written
+        void _close_record() {
+            if (!open) return;
+            const auto length = static_cast<std::uint32_t>(bytes.size() - record_start - 3 * sizeof(std::uint32_t));
+            std::memcpy(bytes.data() + record_start + 8, &length, sizeof(length));
+            open = false;
+        }
+
+        std::vector<std::uint8_t> bytes;
+        std::size_t record_start = 0;
+        bool open = false;
+        std::size_t read_pos = 0;
+        std::size_t record_end = 0;
+        std::size_t n_calls = 0;
+    };
+};
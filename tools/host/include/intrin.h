@@ -0,0 +1,4 @@
+#pragma once
+
+// Host stand-in for MSVC's <intrin.h>; Profiling.h only needs __rdtsc
+#include <x86intrin.h>
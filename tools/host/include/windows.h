@@ -0,0 +1,7 @@
+#pragma once
+
+// Host stand-in for the one Win32 call Utils.h makes
+constexpr unsigned int MB_OK = 0x0;
+constexpr unsigned int MB_ICONERROR = 0x10;
+
+inline int MessageBoxA(void*, const char*, const char*, unsigned int) { return 1; }
@@ -0,0 +1,481 @@
+#include "Host/Bench.h"
+#include "DynamicFormTracker.h"
+
+// Replays a trace written by TraceRecorder through the tracker against the stand-in form registry, and prints
+// per op what the recorded session took next to what the replay takes. Save and load of the cosave, which the game
+// does around SendData and ReceiveData, go through the in-memory SerializationInterface.
+//
+// Bases are created from the (formid, editorid, form type) of the calls that used them. Dynamic formids differ
+// between the session and the replay, so they are mapped through the results of the fetches; calls on a formid the
+// replay never handed out are skipped and counted.
+//
+//   dft_replay <trace> [--csv out.csv] [--baseline earlier.csv]    replay, optionally A/B against an earlier run
+//   dft_replay --synthesize <trace>                                 record a scripted session, to try the tool
+
+namespace {
+
+    using Op = TraceRecorder::Op;
+
+    struct Record {
+        Op op;
+        std::uint8_t flags;
+        RE::FormType base_type;
+        std::uint64_t start;
+        std::uint32_t duration;
+        FormID base_formid;
+        Utilities::Types::EditorIDHandle editorid;
+        std::uint32_t arg;
+        std::uint32_t result;
+        std::vector<std::uint32_t> payload;
+    };
+
+    struct Trace {
+        std::unordered_map<Utilities::Types::EditorIDHandle, std::string> editorids{{0, ""}};
+        std::vector<Record> records;
+
+        [[nodiscard]] const std::string& EditorID(const Record& a_record) const {
+            static const std::string empty;
+            const auto it = editorids.find(a_record.editorid);
+            return it != editorids.end() ? it->second : empty;
+        }
+    };
+
+    std::optional<Trace> ReadTrace(const std::filesystem::path& a_path) {
+        std::ifstream file(a_path, std::ios::binary);
+        const std::vector<std::uint8_t> bytes{std::istreambuf_iterator<char>(file), {}};
+        Utilities::Types::PackedReader reader(bytes);
+
+        std::uint32_t magic = 0;
+        std::uint16_t version = 0;
+        if (!reader.Read(magic) || magic != TraceRecorder::kMagic || !reader.Read(version)) {
+            std::cerr << std::format("{} is not a tracker trace\n", a_path.string());
+            return std::nullopt;
+        }
+        if (version != TraceRecorder::kVersion) {
+            std::cerr << std::format("{} is a version {} trace, this replay reads version {}\n", a_path.string(),
+                                     version, TraceRecorder::kVersion);
+            return std::nullopt;
+        }
+
+        Trace trace;
+        Op op{};
+        while (reader.Read(op)) {
+            if (op == Op::kDefineEditorID) {
+                Utilities::Types::EditorIDHandle handle = 0;
+                std::string editorid;
+                if (!reader.Read(handle) || !reader.Read(editorid)) break;
+                trace.editorids[handle] = std::move(editorid);
+                continue;
+            }
+            Record record{};
+            record.op = op;
+            std::uint8_t base_type = 0;
+            std::uint32_t n_payload = 0;
+            if (!reader.Read(record.flags) || !reader.Read(base_type) || !reader.Read(record.start) ||
+                !reader.Read(record.duration) || !reader.Read(record.base_formid) || !reader.Read(record.editorid) ||
+                !reader.Read(record.arg) || !reader.Read(record.result) || !reader.Read(n_payload) ||
+                reader.Remaining() < static_cast<std::size_t>(n_payload) * sizeof(std::uint32_t)) {
+                break;
+            }
+            record.base_type = static_cast<RE::FormType>(base_type);
+            record.payload.resize(n_payload);
+            for (auto& word : record.payload) reader.Read(word);
+            trace.records.push_back(std::move(record));
+        }
+        if (reader.Remaining()) {
+            std::cerr << std::format("{}: {} trailing bytes after a truncated record, ignored\n", a_path.string(),
+                                     reader.Remaining());
+        }
+        return trace;
+    }
+
+    std::string_view OpName(const Op a_op) {
+        switch (a_op) {
+            case Op::kFetch:
+                return "Fetch";
+            case Op::kFetchCreate:
+                return "FetchCreate";
+            case Op::kFetchCreateMany:
+                return "FetchCreateMany";
+            case Op::kDelete:
+                return "Delete";
+            case Op::kDeleteMany:
+                return "DeleteMany";
+            case Op::kDeleteInactives:
+                return "DeleteInactives";
+            case Op::kEditCustomID:
+                return "EditCustomID";
+            case Op::kSendData:
+                return "SendData";
+            case Op::kReceiveData:
+                return "ReceiveData";
+            case Op::kReset:
+                return "Reset";
+            case Op::kFetchMany:
+                return "FetchMany";
+            case Op::kEditCustomIDs:
+                return "EditCustomIDs";
+            case Op::kPrewarm:
+                return "Prewarm";
+            case Op::kRevalidateStale:
+                return "RevalidateStale";
+            default:
+                return "?";
+        }
+    }
+
+    struct OpStats {
+        std::vector<std::uint64_t> recorded;
+        std::vector<std::uint64_t> replayed;
+        std::uint64_t allocs = 0;
+        std::size_t mismatches = 0;
+    };
+
+    class Replayer {
+    public:
+        explicit Replayer(const Trace& a_trace) : trace(a_trace) {}
+
+        // the registry owns the forms, as the game does; the tracker goes first
+        ~Replayer() {
+            tracker.reset();
+            Host::FormRegistry::Get().Clear();
+        }
+
+        void Run() {
+            _add_bases();
+            tracker = std::make_unique<DynamicFormTracker>();
+            for (const auto& record : trace.records) _replay(record);
+        }
+
+        void Print(std::vector<Host::Bench::Result>& a_results,
+                   const std::map<std::string, Host::Bench::Result, std::less<>>& a_baseline) {
+            std::cout << std::format("{:<24} {:>9} {:>13} {:>13} {:>13} {:>13} {:>10} {:>10}\n", "op", "n",
+                                     "rec p50 ns", "rec p99 ns", "p50 ns", "p99 ns", "allocs/op", "mismatch");
+            for (auto& [name, stats] : stats_by_op) {
+                const auto n = stats.replayed.size();
+                auto result = Host::Bench::Summarize(name, stats.replayed, stats.allocs);
+                const auto rec_p50 = Host::Bench::Percentile(stats.recorded, .5);
+                const auto rec_p99 = Host::Bench::Percentile(stats.recorded, .99);
+                // the replay-only ops have nothing recorded to compare with
+                const auto recorded = [&](const double a_ns) {
+                    return stats.recorded.empty() ? std::string("-") : std::format("{:.0f}", a_ns);
+                };
+                std::cout << std::format("{:<24} {:>9} {:>13} {:>13} {:>13.0f} {:>13.0f} {:>10.2f} {:>10}", name, n,
+                                         recorded(rec_p50), recorded(rec_p99), result.p50_ns, result.p99_ns,
+                                         result.allocs_per_op, stats.mismatches);
+                if (const auto it = a_baseline.find(name); it != a_baseline.end() && it->second.p50_ns > 0.) {
+                    std::cout << std::format("   p50 x{:.2f} p99 x{:.2f} vs baseline", result.p50_ns / it->second.p50_ns,
+                                             result.p99_ns / it->second.p99_ns);
+                }
+                std::cout << '\n';
+                a_results.push_back(std::move(result));
+            }
+            std::cout << std::format("{} records, {} bases, {} formids mapped, {} calls on unmapped formids skipped\n",
+                                     trace.records.size(), n_bases, formid_map.size(), n_unmapped);
+        }
+
+    private:
+        // every base a call resolved in the session, with the form type it had there
+        void _add_bases() {
+            auto& registry = Host::FormRegistry::Get();
+            registry.Clear();
+            std::set<std::pair<FormID, std::string>> added;
+            FormID next_formid = 0x00F00000;
+            // Prewarm knows its base only by editorid, so those get a formid after the others are in
+            for (const bool by_editorid : {false, true}) {
+                for (const auto& record : trace.records) {
+                    if (record.base_type == RE::FormType::None || !record.base_formid != by_editorid) continue;
+                    const auto& editorid = trace.EditorID(record);
+                    if (by_editorid && registry.Find(editorid)) continue;
+                    const auto formid = by_editorid ? next_formid++ : record.base_formid;
+                    if (!added.emplace(formid, editorid).second) continue;
+                    if (registry.AddBase(record.base_type, formid, editorid, std::format("Replay {}", editorid))) {
+                        n_bases++;
+                    }
+                }
+            }
+        }
+
+        [[nodiscard]] std::optional<FormID> _map(const FormID a_recorded) {
+            if (const auto it = formid_map.find(a_recorded); it != formid_map.end()) return it->second;
+            n_unmapped++;
+            return std::nullopt;
+        }
+
+        void _learn(const FormID a_recorded, const FormID a_replayed) {
+            if (a_recorded && a_replayed) formid_map[a_recorded] = a_replayed;
+        }
+
+        // the custom ids a *Many call was made with, and the formids it returned
+        [[nodiscard]] static std::pair<std::vector<std::optional<std::uint32_t>>, std::span<const std::uint32_t>>
+        _split_many(const Record& a_record) {
+            std::vector<std::optional<std::uint32_t>> customIDs;
+            std::span<const std::uint32_t> returned = a_record.payload;
+            if (a_record.flags & TraceRecorder::kHasCustomIDs) {
+                const auto n = std::min<std::size_t>(a_record.arg, a_record.payload.size() / 2);
+                for (std::size_t i = 0; i < n; ++i) {
+                    customIDs.push_back(a_record.payload[2 * i] ? std::optional(a_record.payload[2 * i + 1])
+                                                                : std::nullopt);
+                }
+                returned = returned.subspan(2 * n);
+            }
+            return {std::move(customIDs), returned};
+        }
+
+        template <class Call>
+        void _time(const std::string_view a_name, const Record* a_record, Call&& a_call) {
+            auto& stats = stats_by_op[std::string(a_name)];
+            const auto allocs_before = Host::Bench::GetNAllocs();
+            const auto start = std::chrono::steady_clock::now();
+            const bool matched = a_call();
+            const auto end = std::chrono::steady_clock::now();
+            stats.allocs += Host::Bench::GetNAllocs() - allocs_before;
+            stats.replayed.push_back(std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count());
+            if (a_record) stats.recorded.push_back(a_record->duration);
+            if (!matched) stats.mismatches++;
+        }
+
+        void _replay(const Record& r) {
+            const auto name = OpName(r.op);
+            const auto& editorid = trace.EditorID(r);
+            std::optional<std::uint32_t> customID;
+            if (r.flags & TraceRecorder::kHasCustomID) customID = r.arg;
+
+            switch (r.op) {
+                case Op::kFetch:
+                    _time(name, &r, [&] {
+                        const auto formid = tracker->Fetch(r.base_formid, editorid, customID);
+                        _learn(r.result, formid);
+                        return !formid == !r.result;
+                    });
+                    break;
+                case Op::kFetchCreate:
+                    _time(name, &r, [&] {
+                        const auto formid = tracker->FetchCreate<RE::TESBoundObject>(r.base_formid, editorid, customID);
+                        _learn(r.result, formid);
+                        return !formid == !r.result;
+                    });
+                    break;
+                case Op::kFetchMany:
+                case Op::kFetchCreateMany: {
+                    const auto [customIDs, returned] = _split_many(r);
+                    _time(name, &r, [&] {
+                        const auto formids = r.op == Op::kFetchMany
+                                                 ? tracker->FetchMany(r.base_formid, editorid, r.arg, customIDs)
+                                                 : tracker->FetchCreateMany<RE::TESBoundObject>(r.base_formid,
+                                                                                                editorid, r.arg,
+                                                                                                customIDs);
+                        for (std::size_t i = 0; i < std::min(formids.size(), returned.size()); ++i) {
+                            _learn(returned[i], formids[i]);
+                        }
+                        const auto n_got = static_cast<std::uint32_t>(std::ranges::count_if(formids, std::identity{}));
+                        return n_got == r.result;
+                    });
+                    break;
+                }
+                case Op::kDelete:
+                    if (const auto formid = _map(r.arg)) {
+                        _time(name, &r, [&] {
+                            tracker->Delete(*formid);
+                            return true;
+                        });
+                    }
+                    break;
+                case Op::kDeleteMany: {
+                    std::vector<FormID> formids;
+                    for (const auto recorded : r.payload) {
+                        if (const auto formid = _map(recorded)) formids.push_back(*formid);
+                    }
+                    _time(name, &r, [&] {
+                        tracker->Delete(std::span<const FormID>(formids));
+                        return true;
+                    });
+                    break;
+                }
+                case Op::kDeleteInactives:
+                    _time(name, &r, [&] {
+                        if (!r.arg) {
+                            tracker->DeleteInactives();
+                            return true;
+                        }
+                        return tracker->DeleteInactives(std::chrono::microseconds(r.arg)) == r.result;
+                    });
+                    break;
+                case Op::kEditCustomID:
+                    if (const auto formid = _map(r.base_formid)) {
+                        _time(name, &r, [&] {
+                            tracker->EditCustomID(*formid, r.arg);
+                            return true;
+                        });
+                    }
+                    break;
+                case Op::kEditCustomIDs: {
+                    std::vector<FormID> formids;
+                    std::vector<std::uint32_t> custom_ids;
+                    for (std::size_t i = 0; i + 1 < r.payload.size(); i += 2) {
+                        if (const auto formid = _map(r.payload[i])) {
+                            formids.push_back(*formid);
+                            custom_ids.push_back(r.payload[i + 1]);
+                        }
+                    }
+                    _time(name, &r, [&] {
+                        tracker->EditCustomIDs(formids, custom_ids);
+                        return true;
+                    });
+                    break;
+                }
+                case Op::kSendData:
+                    _time(name, &r, [&] {
+                        tracker->SendData();
+                        return true;
+                    });
+                    _time("Save (replay only)", nullptr, [&] {
+                        cosave = SKSE::SerializationInterface{};
+                        return tracker->Save(&cosave, kRecordType, Utilities::Types::kDFSaveVersion);
+                    });
+                    has_cosave = true;
+                    break;
+                case Op::kReceiveData:
+                    if (has_cosave) {
+                        _time("Load (replay only)", nullptr, [&] {
+                            std::uint32_t type = 0;
+                            std::uint32_t version = 0;
+                            std::uint32_t length = 0;
+                            cosave.Rewind();
+                            return cosave.GetNextRecordInfo(type, version, length) && tracker->Load(&cosave, version);
+                        });
+                    }
+                    _time(name, &r, [&] {
+                        tracker->ReceiveData();
+                        return true;
+                    });
+                    break;
+                case Op::kReset:
+                    _time(name, &r, [&] {
+                        tracker->Reset();
+                        return true;
+                    });
+                    break;
+                case Op::kPrewarm:
+                    _time(name, &r, [&] {
+                        const auto max_create = r.payload.empty() ? SIZE_MAX : r.payload.front();
+                        return tracker->Prewarm(editorid, r.arg, max_create) == r.result;
+                    });
+                    break;
+                case Op::kRevalidateStale:
+                    _time(name, &r, [&] {
+                        tracker->RevalidateStale(std::chrono::microseconds(r.arg));
+                        return true;
+                    });
+                    break;
+                default:
+                    break;
+            }
+        }
+
+        static constexpr std::uint32_t kRecordType = 0x44465452;  // DFTR
+
+        const Trace& trace;
+        std::unique_ptr<DynamicFormTracker> tracker;
+        std::map<std::string, OpStats, std::less<>> stats_by_op;
+        std::unordered_map<FormID, FormID> formid_map;
+        std::size_t n_unmapped = 0;
+        std::size_t n_bases = 0;
+        SKSE::SerializationInterface cosave;
+        bool has_cosave = false;
+    };
+
+    std::map<std::string, Host::Bench::Result, std::less<>> ReadBaseline(const std::filesystem::path& a_path) {
+        std::map<std::string, Host::Bench::Result, std::less<>> baseline;
+        std::ifstream file(a_path);
+        std::string line;
+        std::getline(file, line);
+        while (std::getline(file, line)) {
+            std::stringstream fields(line);
+            Host::Bench::Result result;
+            std::string field;
+            std::getline(fields, result.name, ',');
+            std::getline(fields, field, ',');
+            result.n_ops = std::stoul(field);
+            std::getline(fields, field, ',');
+            std::getline(fields, field, ',');
+            result.p50_ns = std::stod(field);
+            std::getline(fields, field, ',');
+            result.p99_ns = std::stod(field);
+            baseline[result.name] = result;
+        }
+        return baseline;
+    }
+
+    // a short scripted session with the recorder on: a few bases of different types, a load and a cleanup
+    bool Synthesize(const std::string& a_path) {
+        auto& registry = Host::FormRegistry::Get();
+        registry.Clear();
+        const std::array<std::pair<FormID, std::string>, 3> bases{
+            std::pair{0x00012EB7u, "IronSword"}, {0x00012E49u, "ArmorIronCuirass"}, {0x0003AD5Bu, "FoodApple"}};
+        auto* sword = registry.AddBase<RE::TESObjectWEAP>(bases[0].first, bases[0].second, "Iron Sword");
+        sword->weaponData.speed = 1.f;
+        registry.AddBase<RE::TESObjectARMO>(bases[1].first, bases[1].second, "Iron Armor");
+        registry.AddBase<RE::AlchemyItem>(bases[2].first, bases[2].second, "Apple")->food = true;
+
+        auto* recorder = TraceRecorder::GetSingleton();
+        if (!recorder->Start(a_path)) return false;
+
+        DynamicFormTracker tracker;
+        for (const auto& [formid, editorid] : bases) tracker.Prewarm(editorid, 8);
+        std::vector<FormID> created;
+        for (std::uint32_t i = 0; i < 300; ++i) {
+            const auto& [formid, editorid] = bases[i % bases.size()];
+            std::optional<std::uint32_t> customID;
+            if (i % 3 == 0) customID = i;
+            created.push_back(tracker.FetchCreate<RE::TESBoundObject>(formid, editorid, customID));
+        }
+        const std::vector<std::optional<std::uint32_t>> customIDs{1000, std::nullopt, 1002};
+        tracker.FetchCreateMany<RE::TESBoundObject>(bases[0].first, bases[0].second, customIDs.size(), customIDs);
+        tracker.EditCustomID(created[1], 5000);
+        tracker.EditCustomIDs(std::span(created).subspan(4, 2), std::vector<std::uint32_t>{5001, 5002});
+        tracker.Delete(created[2]);
+        tracker.Delete(std::span<const FormID>(created).subspan(10, 5));
+        tracker.SendData();
+
+        tracker.Reset();
+        tracker.ReceiveData();
+        while (tracker.RevalidateStale(std::chrono::microseconds(100))) {}
+        for (std::uint32_t i = 0; i < 300; i += 3) tracker.Fetch(bases[i % 3].first, bases[i % 3].second, i);
+        tracker.FetchMany(bases[1].first, bases[1].second, 20);
+        while (tracker.DeleteInactives(std::chrono::microseconds(100))) {}
+        tracker.SendData();
+        recorder->Stop();
+        registry.Clear();
+        return true;
+    }
+};
+
+int main(int argc, char** argv) {
+    spdlog::set_level(spdlog::level::err);
+
+    if (argc == 3 && std::string_view(argv[1]) == "--synthesize") return Synthesize(argv[2]) ? 0 : 1;
+    if (argc < 2) {
+        std::cerr << "usage: dft_replay <trace> [--csv out.csv] [--baseline earlier.csv]\n"
+                     "       dft_replay --synthesize <trace>\n";
+        return 2;
+    }
+
+    std::optional<std::filesystem::path> csv;
+    std::map<std::string, Host::Bench::Result, std::less<>> baseline;
+    for (int i = 2; i + 1 < argc; i += 2) {
+        const std::string_view option = argv[i];
+        if (option == "--csv") csv = argv[i + 1];
+        else if (option == "--baseline") baseline = ReadBaseline(argv[i + 1]);
+    }
+
+    const auto trace = ReadTrace(argv[1]);
+    if (!trace) return 1;
+
+    Replayer replayer(*trace);
+    replayer.Run();
+    std::vector<Host::Bench::Result> results;
+    replayer.Print(results, baseline);
+    if (csv) Host::Bench::WriteCSV(*csv, results);
+    return 0;
+}
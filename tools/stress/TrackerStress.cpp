@@ -0,0 +1,232 @@
+#include "DynamicFormTracker.h"
+
+// Papyrus natives reach the tracker from the VM threads while the game thread saves, loads and sweeps it. This
+// drives the public API the same way from several threads at once, for a build with -DDFT_HOST_SANITIZER=thread:
+//   workers   Fetch/FetchCreate with and without custom ids, FetchMany, EditCustomID(s), GetByCustomID,
+//             ForEachInFormSet, CopyFormSets, GetSourceForms + GetEditorID, IsTracked/IsActive, Delete
+//   game      one frame at a time: SendData + Save, Reset + Load + ReceiveData, DeleteInactives and RevalidateStale
+//             with a frame budget, the queued tasks. Every other load is a save from another session, with a base
+//             this tracker has not seen, so Load interns editorids while the workers look them up.
+// Worker threads only hold formids, never form pointers, as the natives do. After the threads join, the tracker is
+// checked for formsets, custom ids and flags that disagree.
+//
+//   dft_tracker_stress [workers] [seconds] [seed]
+
+// libstdc++ before GCC 13 guards std::atomic<std::shared_ptr> with a lock bit in the pointer that TSan is not told
+// about, so every store of a published tracker cache looks like a race with its loads.
+extern "C" const char* __tsan_default_suppressions() { return "race:std::_Sp_atomic\n"; }
+
+namespace {
+
+    constexpr std::uint32_t kRecordType = 0x44465453;  // DFTS
+    constexpr auto kFrameBudget = std::chrono::microseconds(200);
+    constexpr std::size_t kNBases = 8;
+    constexpr std::uint32_t kNCustomIDs = 64;
+
+    struct Base {
+        FormID formid;
+        std::string editorid;
+    };
+
+    struct Counters {
+        std::atomic<std::uint64_t> n_ops = 0;
+        std::atomic<std::uint64_t> n_frames = 0;
+        std::atomic<std::uint64_t> n_loads = 0;
+        std::atomic<std::uint64_t> n_failed_loads = 0;
+    };
+
+    void Worker(DynamicFormTracker& a_tracker, const std::vector<Base>& a_bases, const std::atomic<bool>& a_stop,
+                Counters& a_counters, const std::uint64_t a_seed) {
+        std::mt19937_64 rng(a_seed);
+        const auto pick = [&](const std::size_t a_n) { return static_cast<std::size_t>(rng() % a_n); };
+        std::vector<FormID> held;
+        std::vector<RE::TESForm*> base_forms;
+        for (const auto& base : a_bases) base_forms.push_back(RE::TESForm::LookupByID(base.formid));
+
+        while (!a_stop.load(std::memory_order_relaxed)) {
+            const auto& base = a_bases[pick(a_bases.size())];
+            const auto customID = pick(2) ? std::optional(static_cast<std::uint32_t>(pick(kNCustomIDs))) : std::nullopt;
+            switch (pick(12)) {
+                case 0:
+                case 1:
+                    if (const auto formid = a_tracker.FetchCreate<RE::TESBoundObject>(base.formid, base.editorid, customID)) {
+                        held.push_back(formid);
+                    }
+                    break;
+                case 2:
+                    if (const auto formid = a_tracker.Fetch(base.formid, base.editorid, customID)) held.push_back(formid);
+                    break;
+                case 3: {
+                    const std::vector<std::optional<std::uint32_t>> customIDs{customID, std::nullopt, 7};
+                    for (const auto formid : a_tracker.FetchMany(base.formid, base.editorid, customIDs.size(), customIDs)) {
+                        if (formid) held.push_back(formid);
+                    }
+                    break;
+                }
+                case 4:
+                    if (!held.empty()) a_tracker.EditCustomID(held[pick(held.size())], customID.value_or(0));
+                    break;
+                case 5:
+                    if (held.size() > 1) {
+                        const std::array<FormID, 2> formids{held[pick(held.size())], held[pick(held.size())]};
+                        const std::array<std::uint32_t, 2> custom_ids{customID.value_or(1), customID.value_or(2)};
+                        a_tracker.EditCustomIDs(formids, custom_ids);
+                    }
+                    break;
+                case 6:
+                    static_cast<void>(a_tracker.GetByCustomID(customID.value_or(0), base.formid, base.editorid));
+                    break;
+                case 7: {
+                    std::size_t n_tracked = 0;
+                    a_tracker.ForEachInFormSet(base.formid, base.editorid,
+                                               [&](const FormID formid) { n_tracked += a_tracker.IsTracked(formid); });
+                    static_cast<void>(n_tracked);
+                    break;
+                }
+                case 8: {
+                    std::vector<FormID> formids;
+                    a_tracker.CopyFormSets(base_forms, formids);
+                    break;
+                }
+                case 9: {
+                    const auto sources = a_tracker.GetSourceForms();
+                    for (const auto& source : *sources) static_cast<void>(a_tracker.GetEditorID(source));
+                    break;
+                }
+                case 10:
+                    for (const auto formid : held) static_cast<void>(a_tracker.IsActive(formid));
+                    break;
+                case 11:
+                    if (!held.empty()) {
+                        const auto i = pick(held.size());
+                        if (pick(2)) a_tracker.Delete(held[i]);
+                        else a_tracker.Delete(std::span<const FormID>(held).subspan(i));
+                        held.resize(i);
+                    }
+                    break;
+                default:
+                    break;
+            }
+            // the player drops what they got, sooner or later
+            if (held.size() > 256) held.erase(held.begin(), held.begin() + 128);
+            a_counters.n_ops.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    // a cosave of another session, which tracked a few forms of one base of its own
+    SKSE::SerializationInterface OtherSession(const std::size_t a_index) {
+        const auto formid = static_cast<FormID>(0x00040000 + a_index);
+        const auto editorid = std::format("DFTStressOtherSession{}", a_index);
+        Host::FormRegistry::Get().AddBase<RE::TESObjectMISC>(formid, editorid, "Other Session Misc");
+
+        DynamicFormTracker other;
+        for (std::uint32_t i = 0; i < 4; ++i) other.FetchCreate<RE::TESBoundObject>(formid, editorid, i);
+        other.SendData();
+        SKSE::SerializationInterface cosave;
+        if (!other.Save(&cosave, kRecordType, Utilities::Types::kDFSaveVersion)) logger::critical("save failed");
+        return cosave;
+    }
+
+    void Game(DynamicFormTracker& a_tracker, std::vector<SKSE::SerializationInterface>& a_other_sessions,
+              const std::atomic<bool>& a_stop, Counters& a_counters) {
+        SKSE::SerializationInterface own;
+        std::size_t n_loads = 0;
+        for (std::uint64_t frame = 0; !a_stop.load(std::memory_order_relaxed); ++frame) {
+            if (frame % 50 == 0) {
+                own = {};
+                a_tracker.SendData();
+                if (!a_tracker.Save(&own, kRecordType, Utilities::Types::kDFSaveVersion)) {
+                    logger::critical("save failed");
+                }
+            }
+            if (frame % 100 == 25) {
+                std::uint32_t type = 0;
+                std::uint32_t version = 0;
+                std::uint32_t length = 0;
+                const auto load = n_loads++;
+                const auto other = load / 2;
+                auto& cosave = load % 2 == 0 || other >= a_other_sessions.size() ? own : a_other_sessions[other];
+                cosave.Rewind();
+                a_tracker.Reset();
+                if (!cosave.GetNextRecordInfo(type, version, length) || !a_tracker.Load(&cosave, version)) {
+                    a_counters.n_failed_loads.fetch_add(1, std::memory_order_relaxed);
+                }
+                a_tracker.ReceiveData();
+                a_counters.n_loads.fetch_add(1, std::memory_order_relaxed);
+            }
+            a_tracker.DeleteInactives(kFrameBudget);
+            a_tracker.RevalidateStale(kFrameBudget);
+            SKSE::GetTaskInterface()->RunTasks();
+            a_counters.n_frames.fetch_add(1, std::memory_order_relaxed);
+            std::this_thread::sleep_for(std::chrono::microseconds(500));
+        }
+    }
+
+    // single threaded again: what the tracker reports must agree with itself
+    std::size_t CheckConsistency(DynamicFormTracker& a_tracker, const std::vector<Base>& a_bases) {
+        std::size_t n_errors = 0;
+        std::set<FormID> seen;
+        for (const auto& base : a_bases) {
+            a_tracker.ForEachInFormSet(base.formid, base.editorid, [&](const FormID formid) {
+                if (!seen.insert(formid).second) {
+                    std::cerr << std::format("{:x} is in more than one formset\n", formid);
+                    n_errors++;
+                }
+                if (!a_tracker.IsTracked(formid)) {
+                    std::cerr << std::format("{:x} is in the formset of {} but not flagged tracked\n", formid, base.editorid);
+                    n_errors++;
+                }
+            });
+            for (std::uint32_t custom_id = 0; custom_id < kNCustomIDs; ++custom_id) {
+                const auto formid = a_tracker.GetByCustomID(custom_id, base.formid, base.editorid);
+                if (formid && !a_tracker.IsTracked(formid)) {
+                    std::cerr << std::format("custom id {} of {} points at untracked {:x}\n", custom_id, base.editorid,
+                                             formid);
+                    n_errors++;
+                }
+            }
+        }
+        return n_errors;
+    }
+};
+
+int main(int argc, char** argv) {
+    spdlog::set_level(spdlog::level::critical);
+
+    const std::size_t n_workers = argc > 1 ? std::stoul(argv[1]) : 4;
+    const auto seconds = argc > 2 ? std::stod(argv[2]) : 5.;
+    const std::uint64_t seed = argc > 3 ? std::stoull(argv[3]) : 1;
+
+    auto& registry = Host::FormRegistry::Get();
+    std::vector<Base> bases;
+    for (std::size_t b = 0; b < kNBases; ++b) {
+        const auto formid = static_cast<FormID>(0x00030000 + b);
+        auto editorid = std::format("DFTStressMisc{}", b);
+        registry.AddBase<RE::TESObjectMISC>(formid, editorid, std::format("Stress Misc {}", b));
+        bases.push_back({formid, std::move(editorid)});
+    }
+
+    std::vector<SKSE::SerializationInterface> other_sessions;
+    for (std::size_t i = 0; i < 64; ++i) other_sessions.push_back(OtherSession(i));
+
+    auto tracker = std::make_unique<DynamicFormTracker>();
+    Counters counters;
+    std::atomic<bool> stop = false;
+    {
+        std::vector<std::jthread> threads;
+        threads.emplace_back([&] { Game(*tracker, other_sessions, stop, counters); });
+        for (std::size_t i = 0; i < n_workers; ++i) {
+            threads.emplace_back([&, i] { Worker(*tracker, bases, stop, counters, seed * 1000 + i); });
+        }
+        std::this_thread::sleep_for(std::chrono::duration<double>(seconds));
+        stop = true;
+    }
+
+    const auto n_errors = CheckConsistency(*tracker, bases);
+    std::cout << std::format("{} workers, {:.1f} s: {} ops, {} frames, {} loads ({} failed), {} inconsistencies\n",
+                             n_workers, seconds, counters.n_ops.load(), counters.n_frames.load(),
+                             counters.n_loads.load(), counters.n_failed_loads.load(), n_errors);
+    tracker.reset();
+    registry.Clear();
+    return n_errors || counters.n_failed_loads ? 1 : 0;
+}